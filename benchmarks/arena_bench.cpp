@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include <cma/cmalib.h>
+
+#include "perf_counter.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /// @brief Allocations made per iteration before the arena is reset.
+    constexpr std::size_t batch {1024};
+
+    /*
+        A fixed batch of allocations of one size and alignment, followed by a reset (which is part of the
+        measured cost, as it would be per request or frame).
+    */
+    void arena_allocate_bytes(benchmark::State& state) {
+        const auto bytes {static_cast<std::size_t>(state.range(0))};
+        const auto alignment {static_cast<std::size_t>(state.range(1))};
+        cma::arena a{1 << 20};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < batch; ++i) {
+                benchmark::DoNotOptimize(a.allocate_bytes(bytes, alignment));
+            }
+            a.reset();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch));
+    }
+
+    /*
+        A mix of small sizes and alignments drawn from a fixed table, so the branch predictor cannot learn a
+        single size; roughly what a parser or AST builder asks for.
+    */
+    void arena_allocate_bytes_mixed(benchmark::State& state) {
+        constexpr std::array<std::size_t, 8> sizes      {8, 24, 16, 120, 40, 8, 256, 72};
+        constexpr std::array<std::size_t, 8> alignments {8, 8, 16, 8, 64, 4, 16, 8};
+        cma::arena a{1 << 20};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < batch; ++i) {
+                benchmark::DoNotOptimize(a.allocate_bytes(sizes[i % sizes.size()], alignments[(i * 3) % alignments.size()]));
+            }
+            a.reset();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch));
+    }
+
+    struct point {
+        double x, y, z;
+    };
+
+    void arena_make_trivial(benchmark::State& state) {
+        cma::arena a{1 << 20};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < batch; ++i) {
+                benchmark::DoNotOptimize(a.make<point>(1.0, 2.0, 3.0));
+            }
+            a.reset();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch));
+    }
+
+    /// @brief Includes registering (and, on reset, running) each object's destructor.
+    void arena_make_nontrivial(benchmark::State& state) {
+        cma::arena a{1 << 20};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < batch; ++i) {
+                benchmark::DoNotOptimize(a.make<std::string>("short string"));
+            }
+            a.reset();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch));
+    }
+
+    /*
+        Scratch allocations bracketed by a marker, as a function using the arena for temporaries would do.
+        The range is the number of allocations made before rolling back.
+    */
+    void arena_marker_rollback(benchmark::State& state) {
+        const auto allocations {static_cast<std::size_t>(state.range(0))};
+        cma::arena a{1 << 20};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            const auto m {a.create_marker()};
+            for(std::size_t i {0}; i < allocations; ++i) {
+                benchmark::DoNotOptimize(a.allocate_bytes(64, 8));
+            }
+            a.rollback_to(m);
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * allocations));
+    }
+
+    /*
+        One scratch allocation bracketed by a marker, in an arena already holding a long chain of 4 KiB blocks.
+        The range is the number of blocks before the active one; the cost should not depend on it.
+    */
+    void arena_marker_rollback_long_chain(benchmark::State& state) {
+        const auto blocks {static_cast<std::size_t>(state.range(0))};
+        cma::basic_arena<cma::fixed_growth> a{4096};
+        for(std::size_t i {0}; i < blocks; ++i) { a.allocate_bytes(4096, 8); }
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            const auto m {a.create_marker()};
+            benchmark::DoNotOptimize(a.allocate_bytes(64, 8));
+            a.rollback_to(m);
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    }
+
+    void allocator_vector_push_back(benchmark::State& state) {
+        const auto elements {static_cast<std::size_t>(state.range(0))};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            cma::arena a{};
+            std::vector<int, cma::cma_allocator<int>> v{cma::cma_allocator<int>{a}};
+            for(std::size_t i {0}; i < elements; ++i) { v.push_back(static_cast<int>(i)); }
+
+            benchmark::DoNotOptimize(v.data());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+    }
+
+} // namespace
+
+BENCHMARK(arena_allocate_bytes)
+    ->ArgNames({"bytes", "align"})
+    ->Args({8, 8})
+    ->Args({32, 8})
+    ->Args({64, 64})
+    ->Args({256, 16})
+    ->Args({4096, 4096});
+BENCHMARK(arena_allocate_bytes_mixed);
+BENCHMARK(arena_make_trivial);
+BENCHMARK(arena_make_nontrivial);
+BENCHMARK(arena_marker_rollback)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(arena_marker_rollback_long_chain)->Arg(1)->Arg(1000)->Arg(10000);
+BENCHMARK(allocator_vector_push_back)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <cma/concurrent_arena.h>
+#include <cma/sharded_arena.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    /// @brief The baseline: a single-threaded arena behind a mutex.
+    struct locked_arena {
+        std::mutex m;
+        cma::arena a{1 << 20};
+
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment) {
+            std::lock_guard lock{m};
+            return a.allocate_bytes(bytes, alignment);
+        }
+    };
+
+    template<typename Arena>
+    std::unique_ptr<Arena> shared;
+
+    template<typename Arena>
+    void setup(const benchmark::State&) { shared<Arena> = std::make_unique<Arena>(); }
+
+    template<typename Arena>
+    void teardown(const benchmark::State&) { shared<Arena>.reset(); }
+
+    /*
+        Every thread allocates 32-byte objects from the one shared arena. Iterations are fixed so the
+        footprint stays bounded (1 << 20 allocations per thread).
+    */
+    template<typename Arena>
+    void shared_allocate(benchmark::State& state) {
+        Arena& a {*shared<Arena>};
+
+        for(auto _ : state) {
+            benchmark::DoNotOptimize(a.allocate_bytes(32, 8));
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    }
+
+    const int max_threads {static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+
+} // namespace
+
+BENCHMARK_TEMPLATE(shared_allocate, cma::concurrent_arena)
+    ->Setup(setup<cma::concurrent_arena>)->Teardown(teardown<cma::concurrent_arena>)
+    ->ThreadRange(1, max_threads)->Iterations(1 << 20)->UseRealTime();
+
+BENCHMARK_TEMPLATE(shared_allocate, cma::sharded_arena)
+    ->Setup(setup<cma::sharded_arena>)->Teardown(teardown<cma::sharded_arena>)
+    ->ThreadRange(1, max_threads)->Iterations(1 << 20)->UseRealTime();
+
+BENCHMARK_TEMPLATE(shared_allocate, locked_arena)
+    ->Setup(setup<locked_arena>)->Teardown(teardown<locked_arena>)
+    ->ThreadRange(1, max_threads)->Iterations(1 << 20)->UseRealTime();
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <cma/deferred_release.h>
+
+#include <cstring>
+#include <memory>
+
+namespace {
+
+    using deferred_arena = cma::basic_arena<cma::geometric_growth<>, cma::deferred_block_source<>>;
+
+    /*
+        Times only the destruction of an arena holding Range(0) MiB of written memory (so every page is backed,
+        and freeing it means unmapping it). The deferred arena hands its chain to the reclaimer instead, which
+        is drained outside the timed region.
+    */
+    template<typename Arena>
+    void teardown(benchmark::State& state) {
+        const std::size_t bytes {static_cast<std::size_t>(state.range(0)) << 20};
+        std::unique_ptr<Arena> a;
+
+        for(auto _ : state) {
+            state.PauseTiming();
+            cma::block_reclaimer::instance().drain();
+            a = std::make_unique<Arena>(64 * 1024);
+            for(std::size_t filled {0}; filled < bytes; filled += 64 * 1024) {
+                std::memset(a->allocate_bytes(64 * 1024), 0x5A, 64 * 1024);
+            }
+            state.ResumeTiming();
+
+            a.reset();
+        }
+
+        cma::block_reclaimer::instance().drain();
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(teardown, cma::arena)->RangeMultiplier(8)->Range(8, 512)->Iterations(20)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(teardown, deferred_arena)->RangeMultiplier(8)->Range(8, 512)->Iterations(20)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include <cma/cmalib.h>
+#include <cma/virtual_arena.h>
+
+#include "perf_counter.h"
+
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+    constexpr std::size_t elements {10'000'000};
+
+    /// @brief Upstream resource recording the bytes requested from it.
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t bytes {0};
+
+        void* do_allocate(std::size_t n, std::size_t align) override {
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+
+        void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::size_t consumed_bytes(const cma::arena& a) { return a.bytes_in_use(); }
+    std::size_t consumed_bytes(const cma::virtual_arena& a) { return a.used_bytes(); }
+
+    void report(benchmark::State& state, std::size_t consumed) {
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+        state.counters["bytes/element"] = static_cast<double>(consumed) / elements;
+    }
+
+    template<typename Arena>
+    void pmr_vector_cma_resource(benchmark::State& state) {
+        std::size_t consumed {0};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Arena a{};
+            cma::basic_cma_resource r{a};
+            std::pmr::vector<int> v{&r};
+            for(std::size_t i {0}; i < elements; ++i) { v.push_back(static_cast<int>(i)); }
+
+            benchmark::DoNotOptimize(v.data());
+            consumed = consumed_bytes(a);
+        }
+
+        report(state, consumed);
+    }
+
+    void pmr_vector_monotonic(benchmark::State& state) {
+        std::size_t consumed {0};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            counting_resource upstream {};
+            std::pmr::monotonic_buffer_resource r{&upstream};
+            std::pmr::vector<int> v{&r};
+            for(std::size_t i {0}; i < elements; ++i) { v.push_back(static_cast<int>(i)); }
+
+            benchmark::DoNotOptimize(v.data());
+            consumed = upstream.bytes;
+        }
+
+        report(state, consumed);
+    }
+
+    /*
+        A minimal growable buffer: doubles its capacity in place with try_extend while it is the top
+        allocation, and only falls back to allocate-and-copy when it is not. In a block arena the
+        extension fails whenever the active block is full; in a virtual arena it never does.
+    */
+    template<typename Arena>
+    void arena_buffer_try_extend(benchmark::State& state) {
+        std::size_t consumed {0};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Arena a{};
+            std::size_t capacity {16};
+            auto* data {static_cast<int*>(a.allocate_bytes(capacity * sizeof(int), alignof(int)))};
+
+            for(std::size_t i {0}; i < elements; ++i) {
+                if(i == capacity) {
+                    if(!a.try_extend(data, capacity * sizeof(int), capacity * 2 * sizeof(int))) {
+                        auto* grown {static_cast<int*>(a.allocate_bytes(capacity * 2 * sizeof(int), alignof(int)))};
+                        std::memcpy(grown, data, capacity * sizeof(int));
+                        data = grown;
+                    }
+                    capacity *= 2;
+                }
+                data[i] = static_cast<int>(i);
+            }
+
+            benchmark::DoNotOptimize(data);
+            consumed = consumed_bytes(a);
+        }
+
+        report(state, consumed);
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(pmr_vector_cma_resource, cma::arena)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(pmr_vector_cma_resource, cma::virtual_arena)->Unit(benchmark::kMillisecond);
+BENCHMARK(pmr_vector_monotonic)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(arena_buffer_try_extend, cma::arena)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(arena_buffer_try_extend, cma::virtual_arena)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <cma/huge_pages.h>
+
+#include "perf_counter.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct node {
+        node* next;
+        std::byte pad[56];
+    };
+
+    /*
+        Builds a single random cycle through every node so that consecutive loads land on unrelated
+        pages, then chases it; the working set (range(0) bytes) is far larger than the dTLB reach
+        with 4 KiB pages.
+    */
+    template<typename Arena>
+    void pointer_chase(benchmark::State& state) {
+        const auto bytes {static_cast<std::size_t>(state.range(0))};
+        const std::size_t count {bytes / sizeof(node)};
+
+        Arena a{bytes + 4096};
+        std::vector<node*> nodes(count);
+        for(auto& n : nodes) { n = a.template make<node>(); }
+
+        std::ranges::shuffle(nodes, std::mt19937_64{42});
+        for(std::size_t i {0}; i < count; ++i) { nodes[i]->next = nodes[(i + 1) % count]; }
+
+        constexpr std::size_t steps {1 << 20};
+        node* p {nodes.front()};
+        nodes = {};
+
+        cma_bench::perf_counter dtlb{PERF_TYPE_HW_CACHE, cma_bench::dtlb_read_miss};
+        dtlb.start();
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < steps; ++i) { p = p->next; }
+            benchmark::DoNotOptimize(p);
+        }
+
+        const std::uint64_t misses {dtlb.stop()};
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * steps));
+        if(dtlb.valid()) {
+            state.counters["dTLB_miss/step"] = benchmark::Counter(
+                static_cast<double>(misses) / static_cast<double>(state.iterations() * steps));
+        }
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(pointer_chase, cma::arena)->Arg(256 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(pointer_chase, cma::huge_page_arena)->Arg(256 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <cma/offset_ptr.h>
+
+#include "perf_counter.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+    template<template<typename> typename Ptr>
+    struct chase_node {
+        Ptr<chase_node> next;
+        long value;
+    };
+
+    template<typename T>
+    using raw_ptr = T*;
+
+    /*
+        Chases a random cycle through range(0) nodes allocated from an arena, summing their values; the
+        same walk over raw pointers and offset_ptr isolates the cost of the extra add per dereference.
+        Small working sets are dominated by that add, large ones by cache misses.
+    */
+    template<template<typename> typename Ptr>
+    void pointer_chase(benchmark::State& state) {
+        using node = chase_node<Ptr>;
+        const auto count {static_cast<std::size_t>(state.range(0))};
+
+        cma::arena a{count * sizeof(node) + 4096};
+        std::vector<node*> nodes(count);
+        for(std::size_t i {0}; i < count; ++i) { nodes[i] = a.make<node>(nullptr, static_cast<long>(i)); }
+
+        std::ranges::shuffle(nodes, std::mt19937_64{42});
+        for(std::size_t i {0}; i < count; ++i) { nodes[i]->next = nodes[(i + 1) % count]; }
+
+        constexpr std::size_t steps {1 << 16};
+        const node* p {nodes.front()};
+        long sum {0};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            for(std::size_t i {0}; i < steps; ++i) {
+                sum += p->value;
+                p = &*p->next;
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * steps));
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(pointer_chase, raw_ptr)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(pointer_chase, cma::offset_ptr)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cma_bench {
+
+    /**
+     * @brief A single self-monitoring counter opened via @c perf_event_open (hardware events in user space only).
+     *
+     * Counters are unavailable when the kernel forbids access (perf_event_paranoid, containers); @c valid()
+     * reports this so benchmarks can skip the counter rather than fail.
+     */
+    class perf_counter {
+    public:
+
+        perf_counter(std::uint32_t type, std::uint64_t config) noexcept {
+            perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = type == PERF_TYPE_SOFTWARE ? 0 : 1;   // faults are counted in the kernel's handler
+            attr.exclude_hv = 1;
+
+            _fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        perf_counter(const perf_counter&) = delete;
+
+        perf_counter& operator=(const perf_counter&) = delete;
+
+        ~perf_counter() { if(_fd >= 0) { ::close(_fd); } }
+
+        bool valid() const noexcept { return _fd >= 0; }
+
+        void start() noexcept {
+            if(_fd < 0) { return; }
+            ::ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+
+        std::uint64_t stop() noexcept {
+            if(_fd < 0) { return 0; }
+            ::ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            std::uint64_t value {0};
+            if(::read(_fd, &value, sizeof(value)) != sizeof(value)) { return 0; }
+            return value;
+        }
+
+    private:
+        int _fd {-1};
+    };
+
+    /// @brief Config for data TLB read misses.
+    inline constexpr std::uint64_t dtlb_read_miss {
+        PERF_COUNT_HW_CACHE_DTLB
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    /// @brief Config for last-level cache misses (rather than PERF_COUNT_HW_CACHE_MISSES, whose meaning varies by CPU).
+    inline constexpr std::uint64_t llc_read_miss {
+        PERF_COUNT_HW_CACHE_LL
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    /// @brief Config for L1 data cache read misses.
+    inline constexpr std::uint64_t l1d_read_miss {
+        PERF_COUNT_HW_CACHE_L1D
+        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    /**
+     * @brief Whether counters were requested for this run (@c CMA_BENCH_PERF=1 in the environment).
+     */
+    inline bool perf_enabled() noexcept {
+        static const bool enabled {[] {
+            const char* v {std::getenv("CMA_BENCH_PERF")};
+            return v && *v && *v != '0';
+        }()};
+        return enabled;
+    }
+
+    /**
+     * @brief Counts a benchmark's timed loop and reports the counts per iteration next to its timings.
+     *
+     * Constructed right before the @c for(auto _ : state) loop and destroyed after it. Does nothing unless
+     * @c perf_enabled(); counters the kernel refuses are simply left out of the report.
+     */
+    class perf_scope {
+    public:
+
+        explicit perf_scope(benchmark::State& state) noexcept
+            : _state{state}
+        {
+            if(!perf_enabled()) { return; }
+
+            for(std::size_t i {0}; i < events.size(); ++i) {
+                _counters[i].emplace(events[i].type, events[i].config);
+            }
+            for(auto& c : _counters) { c->start(); }
+        }
+
+        perf_scope(const perf_scope&) = delete;
+
+        perf_scope& operator=(const perf_scope&) = delete;
+
+        ~perf_scope() {
+            for(std::size_t i {0}; i < events.size(); ++i) {
+                if(!_counters[i] || !_counters[i]->valid()) { continue; }
+
+                const std::uint64_t value {_counters[i]->stop()};
+                _state.counters[events[i].name] = benchmark::Counter(
+                    static_cast<double>(value), benchmark::Counter::kAvgIterations);
+            }
+        }
+
+    private:
+
+        struct event {
+            const char* name;
+            std::uint32_t type;
+            std::uint64_t config;
+        };
+
+        static constexpr std::array<event, 7> events {{
+            {"cycles",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"L1d_miss",     PERF_TYPE_HW_CACHE, l1d_read_miss},
+            {"LLC_miss",     PERF_TYPE_HW_CACHE, llc_read_miss},
+            {"dTLB_miss",    PERF_TYPE_HW_CACHE, dtlb_read_miss},
+            {"minor_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MIN},
+            {"major_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ},
+        }};
+
+        benchmark::State& _state;
+
+        std::array<std::optional<perf_counter>, events.size()> _counters {};
+    };
+
+} // namespace cma_bench
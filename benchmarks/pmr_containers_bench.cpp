@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+#include <cma/cmalib.h>
+
+#include "perf_counter.h"
+
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+    Container workloads run against each memory resource. Each iteration builds the resource, fills the
+    container and tears both down, so the cost of releasing memory is measured alongside allocating it.
+*/
+
+namespace {
+
+    /// @brief Resource forwarding to malloc/free (aligned_alloc for over-aligned requests).
+    struct malloc_resource : std::pmr::memory_resource {
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            void* p {alignment <= alignof(std::max_align_t)
+                ? std::malloc(bytes)
+                : std::aligned_alloc(alignment, cma::impl::round_up(bytes, alignment))};
+            if(!p) { throw std::bad_alloc{}; }
+            return p;
+        }
+
+        void do_deallocate(void* p, std::size_t, std::size_t) override { std::free(p); }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    struct cma_kind {
+        cma::arena a{};
+        cma::cma_resource r{a};
+        std::pmr::memory_resource* get() noexcept { return &r; }
+    };
+
+    struct monotonic_kind {
+        std::pmr::monotonic_buffer_resource r{};
+        std::pmr::memory_resource* get() noexcept { return &r; }
+    };
+
+    struct pool_kind {
+        std::pmr::unsynchronized_pool_resource r{};
+        std::pmr::memory_resource* get() noexcept { return &r; }
+    };
+
+    struct new_delete_kind {
+        std::pmr::memory_resource* get() noexcept { return std::pmr::new_delete_resource(); }
+    };
+
+    struct malloc_kind {
+        malloc_resource r{};
+        std::pmr::memory_resource* get() noexcept { return &r; }
+    };
+
+    template<typename Kind>
+    void pmr_vector(benchmark::State& state) {
+        const auto elements {static_cast<std::size_t>(state.range(0))};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Kind k {};
+            std::pmr::vector<int> v{k.get()};
+            for(std::size_t i {0}; i < elements; ++i) { v.push_back(static_cast<int>(i)); }
+
+            benchmark::DoNotOptimize(v.data());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+    }
+
+    template<typename Kind>
+    void pmr_map(benchmark::State& state) {
+        const auto elements {static_cast<std::size_t>(state.range(0))};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Kind k {};
+            std::pmr::map<int, int> m{k.get()};
+            for(std::size_t i {0}; i < elements; ++i) {
+                m.emplace(static_cast<int>((i * 2654435761u) % elements), static_cast<int>(i));
+            }
+
+            benchmark::DoNotOptimize(m.size());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+    }
+
+    template<typename Kind>
+    void pmr_unordered_map(benchmark::State& state) {
+        const auto elements {static_cast<std::size_t>(state.range(0))};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Kind k {};
+            std::pmr::unordered_map<int, int> m{k.get()};
+            for(std::size_t i {0}; i < elements; ++i) { m.emplace(static_cast<int>(i), static_cast<int>(i)); }
+
+            benchmark::DoNotOptimize(m.size());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+    }
+
+    /// @brief Strings past the small-string buffer, each grown by appends (so each reallocates a few times).
+    template<typename Kind>
+    void pmr_string(benchmark::State& state) {
+        const auto elements {static_cast<std::size_t>(state.range(0))};
+
+        cma_bench::perf_scope perf{state};
+
+        for(auto _ : state) {
+            Kind k {};
+            std::pmr::vector<std::pmr::string> v{k.get()};
+            v.reserve(elements);
+            for(std::size_t i {0}; i < elements; ++i) {
+                std::pmr::string& s {v.emplace_back()};
+                for(int j {0}; j < 8; ++j) { s.append("0123456789abcdef"); }
+            }
+
+            benchmark::DoNotOptimize(v.data());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * elements));
+    }
+
+} // namespace
+
+#define CMA_CONTAINER_BENCH(workload, n)                        \
+    BENCHMARK_TEMPLATE(workload, cma_kind)->Arg(n);             \
+    BENCHMARK_TEMPLATE(workload, monotonic_kind)->Arg(n);       \
+    BENCHMARK_TEMPLATE(workload, pool_kind)->Arg(n);            \
+    BENCHMARK_TEMPLATE(workload, new_delete_kind)->Arg(n);      \
+    BENCHMARK_TEMPLATE(workload, malloc_kind)->Arg(n)
+
+CMA_CONTAINER_BENCH(pmr_vector, 1 << 16);
+CMA_CONTAINER_BENCH(pmr_map, 1 << 14);
+CMA_CONTAINER_BENCH(pmr_unordered_map, 1 << 14);
+CMA_CONTAINER_BENCH(pmr_string, 1 << 12);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <cma/async_refill.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+    using cold_arena = cma::basic_arena<cma::geometric_growth<>, cma::aligned_block_source<4096>>;
+    using warm_arena = cma::basic_arena<cma::geometric_growth<>, cma::prefault_block_source<cma::aligned_block_source<4096>>>;
+    using async_arena = cma::basic_arena<cma::geometric_growth<>, cma::async_block_source<cma::aligned_block_source<4096>>>;
+
+    /// @brief Allocations per iteration (32 MiB of 512-byte requests, spanning ~10 doubling blocks).
+    constexpr std::size_t allocations {1 << 16};
+
+    /*
+        Times every allocation (plus writing it, where its page faults land) in a fresh arena, and reports the
+        latency percentiles next to the mean. Range(0) is the number of blocks reserved at construction; with
+        the pre-faulting source those blocks, and their pages, are ready before the first timed allocation. The
+        asynchronous source prepares each block on its helper thread instead, and also reports how many blocks
+        the allocating thread still had to wait for or allocate itself.
+    */
+    template<typename Arena>
+    void allocation_latency(benchmark::State& state) {
+        const auto reserved {static_cast<std::size_t>(state.range(0))};
+        std::vector<std::int64_t> samples;
+        samples.reserve(allocations * 8);
+
+        std::unique_ptr<Arena> a;
+        std::size_t handoffs {0};
+        std::size_t waits {0};
+        std::size_t blocking {0};
+
+        for(auto _ : state) {
+            state.PauseTiming();    // the previous arena's teardown and the new one's construction are not timed
+            a.reset();
+            a = std::make_unique<Arena>(64 * 1024);
+            a->reserve_blocks(reserved);
+            state.ResumeTiming();
+
+            for(std::size_t i {0}; i < allocations; ++i) {
+                const auto start {std::chrono::steady_clock::now()};
+                void* p {a->allocate_bytes(512, 16)};
+                std::memset(p, 0x5A, 512);
+                const auto stop {std::chrono::steady_clock::now()};
+
+                if(samples.size() < samples.capacity()) {
+                    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+                }
+            }
+
+            if constexpr (requires { a->source().stats(); }) {
+                handoffs += a->source().stats().handoffs;
+                waits += a->source().stats().waits;
+                blocking += a->source().stats().blocking;
+            }
+        }
+
+        std::ranges::sort(samples);
+        auto percentile {[&](double q) {
+            return static_cast<double>(samples[static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1))]);
+        }};
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * allocations));
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+        state.counters["max_ns"] = static_cast<double>(samples.back());
+
+        if constexpr (requires { a->source().stats(); }) {
+            state.counters["handoffs"] = benchmark::Counter(static_cast<double>(handoffs), benchmark::Counter::kAvgIterations);
+            state.counters["waits"] = benchmark::Counter(static_cast<double>(waits), benchmark::Counter::kAvgIterations);
+            state.counters["blocking"] = benchmark::Counter(static_cast<double>(blocking), benchmark::Counter::kAvgIterations);
+        }
+    }
+
+} // namespace
+
+BENCHMARK_TEMPLATE(allocation_latency, cold_arena)->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(allocation_latency, warm_arena)->Arg(0)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(allocation_latency, warm_arena)->Arg(10)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(allocation_latency, async_arena)->Arg(0)->Unit(benchmark::kMillisecond);
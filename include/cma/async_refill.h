@@ -0,0 +1,232 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_ASYNC_REFILL_H_INCLUDE
+#define CMA_ASYNC_REFILL_H_INCLUDE
+
+#include <cma/prefault.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+/*
+ * The slow path of an arena allocates (and later faults in) a whole block on the allocating thread. With the
+ * asynchronous block source, the arena instead asks for its next block once the last block is @c fill_percent
+ * full; a helper thread allocates and pre-faults it while the rest of the active block is used, and hands it over
+ * through a single atomic exchange when the arena actually grows.
+ *
+ * The fast path is unchanged: the arena simply bumps toward the fill threshold instead of the block's end, so
+ * crossing it is one extra trip through the slow path per block. If the arena outruns the helper, it waits for
+ * the block in progress rather than starting over; requests that do not match the prepared size (an allocation
+ * larger than the next block) fall back to allocating on the calling thread. Both are counted, so how often the
+ * allocating thread still stalls is visible in @c stats().
+ */
+
+namespace cma {
+
+    /**
+     * @brief Counters of an @c async_block_source.
+     */
+    struct async_refill_stats {
+
+        /// @brief Blocks handed over ready (allocated and faulted in by the helper).
+        std::size_t handoffs {0};
+
+        /// @brief Blocks still being prepared when needed, which the allocating thread waited for.
+        std::size_t waits {0};
+
+        /// @brief Blocks the allocating thread had to allocate itself.
+        std::size_t blocking {0};
+    };
+
+    /**
+     * @brief Block source preparing the arena's next block on a helper thread.
+     * @tparam Upstream The (thread-safe) block source storage is drawn from.
+     */
+    template<block_source Upstream = heap_block_source>
+    class async_block_source {
+    public:
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        /// @brief How full (in percent) the last block gets before the next one is prepared.
+        static constexpr std::size_t fill_percent {50};
+
+        async_block_source() = default;
+
+        explicit async_block_source(Upstream upstream)
+            : _state{std::make_unique<state>(std::move(upstream))}
+        {}
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return _state->upstream.round_size(bytes); }
+
+        /**
+         * @brief Takes the prepared block if it has exactly @p bytes (waiting for the helper to finish it if
+         *        needed), otherwise allocates on the calling thread.
+         * @throws std::bad_alloc if the upstream source fails.
+         */
+        void* allocate(std::size_t bytes) {
+            state& s {*_state};
+            std::atomic<std::size_t>* counter {&s.handoffs};
+
+            // A block of the right size that is still being prepared is finished sooner by the helper. One just
+            // published is waited out too, so the request is cleared before the next prepare() looks at it.
+            if(s.request.load(std::memory_order_acquire) == bytes) {
+                if(!s.ready.load(std::memory_order_acquire)) { counter = &s.waits; }
+                s.request.wait(bytes, std::memory_order_acquire);
+            }
+
+            if(void* p {s.ready.exchange(nullptr, std::memory_order_acquire)}) {
+                const std::size_t ready_bytes {s.ready_bytes.load(std::memory_order_relaxed)};
+                if(ready_bytes == bytes) {
+                    counter->fetch_add(1, std::memory_order_relaxed);
+                    return p;
+                }
+                s.upstream.deallocate(p, ready_bytes);
+            }
+
+            s.blocking.fetch_add(1, std::memory_order_relaxed);
+            return s.upstream.allocate(bytes);
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept { _state->upstream.deallocate(p, bytes); }
+
+        /**
+         * @brief Asks the helper to prepare a block of @p bytes, unless one is already prepared or in progress.
+         * @note Starts the helper thread on first use.
+         */
+        void prepare(std::size_t bytes) noexcept {
+            state& s {*_state};
+            if(s.ready.load(std::memory_order_relaxed) || s.request.load(std::memory_order_relaxed) != 0) { return; }
+
+            if(!s.helper.joinable()) {
+                try {
+                    s.helper = std::thread{[&s] { s.run(); }};
+                } catch (...) {
+                    return;     // no helper: every block is allocated on demand
+                }
+            }
+
+            s.request.store(bytes, std::memory_order_release);
+            s.request.notify_one();
+        }
+
+        /**
+         * @brief Blocks until the helper is done with the block asked for by @c prepare, if any.
+         * @returns Whether a prepared block is waiting to be handed over.
+         * @note For tests and benchmarks wanting a deterministic hand-over; arenas never need to call it.
+         */
+        bool wait_prepared() const noexcept {
+            const state& s {*_state};
+
+            for(std::size_t r {s.request.load(std::memory_order_acquire)}; r != 0 && r != state::stop;
+                r = s.request.load(std::memory_order_acquire)) {
+                s.request.wait(r, std::memory_order_acquire);
+            }
+
+            return s.ready.load(std::memory_order_acquire) != nullptr;
+        }
+
+        async_refill_stats stats() const noexcept {
+            return async_refill_stats{
+                _state->handoffs.load(std::memory_order_relaxed),
+                _state->waits.load(std::memory_order_relaxed),
+                _state->blocking.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+
+        /**
+         * @brief State shared with the helper thread; heap allocated so the source itself may be moved.
+         */
+        struct state {
+
+            /// @brief Request value telling the helper to exit.
+            static constexpr std::size_t stop {std::numeric_limits<std::size_t>::max()};
+
+            [[no_unique_address]] Upstream upstream;
+
+            /// @brief Size of the block the helper should prepare (0 = none).
+            std::atomic<std::size_t> request {0};
+
+            /// @brief The prepared block, published by the helper.
+            std::atomic<void*> ready {nullptr};
+
+            /// @brief Size of @c ready (written before @c ready is published).
+            std::atomic<std::size_t> ready_bytes {0};
+
+            std::atomic<std::size_t> handoffs {0};
+            std::atomic<std::size_t> waits {0};
+            std::atomic<std::size_t> blocking {0};
+
+            std::thread helper;
+
+            explicit state(Upstream u = {}) : upstream{std::move(u)} {}
+
+            ~state() {
+                if(helper.joinable()) {
+                    request.store(stop, std::memory_order_release);
+                    request.notify_one();
+                    helper.join();
+                }
+
+                if(void* p {ready.load(std::memory_order_acquire)}) {
+                    upstream.deallocate(p, ready_bytes.load(std::memory_order_relaxed));
+                }
+            }
+
+            void run() noexcept {
+                for(;;) {
+                    request.wait(0, std::memory_order_acquire);
+
+                    const std::size_t bytes {request.load(std::memory_order_acquire)};
+                    if(bytes == stop) { return; }
+
+                    try {
+                        void* p {upstream.allocate(bytes)};
+                        impl::prefault(p, bytes);
+                        ready_bytes.store(bytes, std::memory_order_relaxed);
+                        ready.store(p, std::memory_order_release);
+                    } catch (...) {
+                        // The arena allocates the block itself when it gets there.
+                    }
+
+                    std::size_t expected {bytes};
+                    request.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+                    request.notify_all();
+                }
+            }
+        };
+
+        std::unique_ptr<state> _state {std::make_unique<state>()};
+    };
+
+    /**
+     * @brief Arena whose next block is prepared on a helper thread.
+     */
+    using async_arena = basic_arena<geometric_growth<>, async_block_source<>>;
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,390 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_BLOCK_CACHE_H_INCLUDE
+#define CMA_BLOCK_CACHE_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+/*
+ * Short-lived arenas pay for a block in their constructor and return every block when destroyed. The block cache
+ * sits between arenas and an upstream block source, keeping freed blocks in size-class buckets so the next arena
+ * (or slow path) can pick them up again without a system allocation.
+ *
+ * Size classes are quarter steps between powers of two (4, 5, 6, 7, 8, 10, 12, 14, 16 KiB, ...), bounding the
+ * rounding waste at 25%. Each thread keeps a few blocks per class, and a few MiB in all, in a front cache (no
+ * locking); overflow and blocks flushed by exiting threads go to a global back cache under a mutex. A single byte
+ * limit bounds everything cached, front caches included, so no thread can pin memory beyond it.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Snapshot of a block cache's counters.
+     */
+    struct block_cache_stats {
+
+        /// @brief Requests served from a thread's front cache.
+        std::size_t front_hits {0};
+
+        /// @brief Requests served from the global back cache.
+        std::size_t back_hits {0};
+
+        /// @brief Requests forwarded to the upstream block source.
+        std::size_t misses {0};
+
+        /// @brief Bytes currently held by the cache (front and back).
+        std::size_t cached_bytes {0};
+    };
+
+    /**
+     * @brief Process-wide, size-bucketed cache of blocks drawn from an upstream block source.
+     * @tparam Upstream The (stateless) block source that cached blocks come from and are returned to.
+     */
+    template<block_source Upstream = heap_block_source>
+    class block_cache {
+    public:
+
+        static_assert(std::is_empty_v<Upstream>, "A process-wide cache requires a stateless upstream source!");
+
+        /// @brief log2 of the smallest size class.
+        static constexpr std::size_t min_shift {12};
+
+        /// @brief log2 of the largest size class; larger blocks bypass the cache.
+        static constexpr std::size_t max_shift {28};
+
+        /// @brief Number of size classes.
+        static constexpr std::size_t class_count {(max_shift - min_shift) * 4 + 1};
+
+        /// @brief Blocks kept per size class in each thread's front cache.
+        static constexpr std::size_t front_depth {4};
+
+        /// @brief Bytes kept in all in each thread's front cache; blocks past it go to the back cache.
+        static constexpr std::size_t front_limit {std::size_t{32} << 20};
+
+        /**
+         * @brief The process-wide cache for @c Upstream.
+         * @note Intentionally never destroyed, so arenas with static storage may still return blocks at exit
+         *       (past the exiting thread's front cache, which is destroyed first, straight to the back cache).
+         */
+        static block_cache& instance() noexcept {
+            static block_cache* cache {new block_cache{}};
+            return *cache;
+        }
+
+        /**
+         * @brief Rounds a block size to its size class (and then to the upstream granularity).
+         */
+        static std::size_t round_size(std::size_t bytes) noexcept {
+            if(bytes > (std::size_t{1} << max_shift)) { return Upstream{}.round_size(bytes); }
+            return Upstream{}.round_size(class_size(class_of(bytes)));
+        }
+
+        /**
+         * @brief Obtains a block of exactly @p bytes, from the cache when possible.
+         * @throws std::bad_alloc if the upstream source fails.
+         */
+        void* acquire(std::size_t bytes) {
+            const std::size_t c {cacheable_class(bytes)};
+
+            if(c != class_count) {
+                front* f {local_front()};
+                if(node* n {f ? f->pop(c, bytes) : nullptr}) {
+                    _cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                    _front_hits.fetch_add(1, std::memory_order_relaxed);
+                    return n;
+                }
+
+                std::lock_guard lock{_mutex};
+                if(node* n {_back[c]}) {
+                    _back[c] = n->next;
+                    _cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                    _back_hits.fetch_add(1, std::memory_order_relaxed);
+                    return n;
+                }
+            }
+
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return Upstream{}.allocate(bytes);
+        }
+
+        /**
+         * @brief Returns a block of @p bytes to the cache, or upstream once the cache is full.
+         */
+        void release(void* p, std::size_t bytes) noexcept {
+            const std::size_t c {cacheable_class(bytes)};
+
+            if(c != class_count && charge(bytes)) {
+                front* f {local_front()};
+                if(!f || !f->push(c, p, bytes)) { push_back(c, p); }
+                return;
+            }
+
+            Upstream{}.deallocate(p, bytes);
+        }
+
+        /**
+         * @brief Returns every block held by the global back cache and the calling thread's front cache upstream.
+         * @note Other threads return their front caches upstream on their next use of the cache (until then, what
+         *       they hold still counts against the limit).
+         */
+        void trim() noexcept {
+            _generation.fetch_add(1, std::memory_order_relaxed);
+            local_front();
+
+            std::array<node*, class_count> lists {};
+            {
+                std::lock_guard lock{_mutex};
+                lists = _back;
+                _back = {};
+            }
+
+            for(std::size_t c {0}; c < class_count; ++c) {
+                const std::size_t bytes {class_bytes(c)};
+
+                for(node* n {lists[c]}; n;) {
+                    node* next {n->next};
+                    Upstream{}.deallocate(n, bytes);
+                    _cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                    n = next;
+                }
+            }
+        }
+
+        /**
+         * @brief Sets the number of bytes the cache may hold, front caches included (default = 256 MiB).
+         * @note Lowering the limit frees nothing; blocks are refused until the cache falls below it.
+         */
+        void set_limit(std::size_t bytes) noexcept { _limit.store(bytes, std::memory_order_relaxed); }
+
+        block_cache_stats stats() const noexcept {
+            return block_cache_stats{
+                _front_hits.load(std::memory_order_relaxed),
+                _back_hits.load(std::memory_order_relaxed),
+                _misses.load(std::memory_order_relaxed),
+                _cached_bytes.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+
+        /// @brief Intrusive free-list link, stored in the cached block itself.
+        struct node {
+            node* next;
+        };
+
+        /**
+         * @brief A thread's front cache; flushed to the back cache when the thread exits.
+         */
+        struct front {
+            std::array<node*, class_count> lists {};
+            std::array<std::uint8_t, class_count> counts {};
+
+            /// @brief Bytes held, bounded by @c front_limit.
+            std::size_t bytes {0};
+
+            /// @brief The cache's trim generation this front was last flushed for.
+            std::size_t generation {0};
+
+            ~front() {
+                front_destroyed() = true;
+                flush(instance(), false);
+            }
+
+            node* pop(std::size_t c, std::size_t block_bytes) noexcept {
+                node* n {lists[c]};
+                if(n) {
+                    lists[c] = n->next;
+                    --counts[c];
+                    bytes -= block_bytes;
+                }
+                return n;
+            }
+
+            bool push(std::size_t c, void* p, std::size_t block_bytes) noexcept {
+                if(counts[c] == front_depth || block_bytes > front_limit - bytes) { return false; }
+
+                auto* n {::new (p) node{lists[c]}};
+                lists[c] = n;
+                ++counts[c];
+                bytes += block_bytes;
+                return true;
+            }
+
+            /**
+             * @brief Empties the front into the back cache, or upstream if @p trimming.
+             */
+            void flush(block_cache& cache, bool trimming) noexcept {
+                for(std::size_t c {0}; c < class_count && bytes != 0; ++c) {
+                    const std::size_t block_bytes {class_bytes(c)};
+
+                    while(node* n {pop(c, block_bytes)}) {
+                        if(trimming) {
+                            Upstream{}.deallocate(n, block_bytes);
+                            cache._cached_bytes.fetch_sub(block_bytes, std::memory_order_relaxed);
+                        } else {
+                            cache.push_back(c, n);
+                        }
+                    }
+                }
+            }
+        };
+
+        std::mutex _mutex;
+
+        /// @brief Global back cache, one free-list per size class (guarded by @c _mutex).
+        std::array<node*, class_count> _back {};
+
+        /// @brief Limit on @c _cached_bytes.
+        std::atomic<std::size_t> _limit {std::size_t{256} << 20};
+
+        /// @brief Bumped by @c trim(), telling every front cache to return its blocks upstream on next use.
+        std::atomic<std::size_t> _generation {0};
+
+        std::atomic<std::size_t> _front_hits {0};
+        std::atomic<std::size_t> _back_hits {0};
+        std::atomic<std::size_t> _misses {0};
+
+        /// @brief Bytes held by the front caches and the back cache, charged before a block is cached.
+        std::atomic<std::size_t> _cached_bytes {0};
+
+        block_cache() = default;
+
+        static front& local() noexcept {
+            thread_local front f {};
+            return f;
+        }
+
+        /**
+         * @brief Whether the calling thread's front cache is gone (the thread is exiting); being trivially
+         *        destructible, the flag itself stays readable until the thread ends.
+         */
+        static bool& front_destroyed() noexcept {
+            thread_local bool destroyed {false};
+            return destroyed;
+        }
+
+        /**
+         * @brief The calling thread's front cache, first emptied upstream if the cache was trimmed since its last use;
+         *        @c nullptr once it has been destroyed.
+         */
+        front* local_front() noexcept {
+            if(front_destroyed()) { return nullptr; }
+
+            front& f {local()};
+
+            const std::size_t generation {_generation.load(std::memory_order_relaxed)};
+            if(f.generation != generation) {
+                f.generation = generation;
+                f.flush(*this, true);
+            }
+
+            return &f;
+        }
+
+        /**
+         * @brief Charges a block of @p bytes to the cached bytes, unless that would exceed the limit.
+         */
+        bool charge(std::size_t bytes) noexcept {
+            const std::size_t limit {_limit.load(std::memory_order_relaxed)};
+
+            std::size_t cached {_cached_bytes.load(std::memory_order_relaxed)};
+            do {
+                if(bytes > limit || cached > limit - bytes) { return false; }
+            } while(!_cached_bytes.compare_exchange_weak(cached, cached + bytes, std::memory_order_relaxed));
+            return true;
+        }
+
+        /**
+         * @brief Links a (charged) block into the back cache.
+         */
+        void push_back(std::size_t c, void* p) noexcept {
+            std::lock_guard lock{_mutex};
+            _back[c] = ::new (p) node{_back[c]};
+        }
+
+        /**
+         * @brief Index of the smallest size class holding @p bytes (<= 2^max_shift).
+         */
+        static constexpr std::size_t class_of(std::size_t bytes) noexcept {
+            if(bytes <= (std::size_t{1} << min_shift)) { return 0; }
+
+            const std::size_t shift {static_cast<std::size_t>(std::bit_width(bytes) - 1)};
+            const std::size_t step {std::size_t{1} << (shift - 2)};
+            const std::size_t quarter {(bytes - (std::size_t{1} << shift) + step - 1) / step};
+
+            return (shift - min_shift) * 4 + quarter;
+        }
+
+        /**
+         * @brief Size in bytes of size class @p c, before upstream rounding.
+         */
+        static constexpr std::size_t class_size(std::size_t c) noexcept {
+            const std::size_t shift {min_shift + c / 4};
+            return (4 + c % 4) << (shift - 2);
+        }
+
+        /**
+         * @brief Size in bytes of the blocks held in size class @p c.
+         */
+        static std::size_t class_bytes(std::size_t c) noexcept {
+            return Upstream{}.round_size(class_size(c));
+        }
+
+        /**
+         * @brief Size class for a block of exactly @p bytes, or @c class_count if such blocks are not cached.
+         */
+        static std::size_t cacheable_class(std::size_t bytes) noexcept {
+            if(bytes > (std::size_t{1} << max_shift)) { return class_count; }
+
+            const std::size_t c {class_of(bytes)};
+            return class_bytes(c) == bytes ? c : class_count;
+        }
+    };
+
+    /**
+     * @brief Block source drawing from (and returning to) the process-wide @c block_cache.
+     * @tparam Upstream The block source behind the cache.
+     */
+    template<block_source Upstream = heap_block_source>
+    struct cached_block_source {
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return block_cache<Upstream>::round_size(bytes); }
+
+        void* allocate(std::size_t bytes) { return block_cache<Upstream>::instance().acquire(bytes); }
+
+        void deallocate(void* p, std::size_t bytes) noexcept { block_cache<Upstream>::instance().release(p, bytes); }
+    };
+
+    /**
+     * @brief Arena drawing its blocks from the process-wide block cache.
+     */
+    using cached_arena = basic_arena<geometric_growth<>, cached_block_source<>>;
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_BUDGET_H_INCLUDE
+#define CMA_BUDGET_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <atomic>
+
+/*
+ * An arena grows for as long as its block source delivers, so one pathological request can keep doubling blocks
+ * until the machine runs out of memory. A memory budget caps the block storage an arena (or a group of arenas)
+ * may hold. It is charged by the budgeted block source, before the upstream source is asked for anything, and
+ * credited when blocks are freed; allocations served from existing blocks never see it.
+ *
+ * Going over the soft limit calls a handler once (re-armed when usage falls back below it), so the application
+ * can shed load or spill. A block that would exceed the hard limit is refused: @c allocate_bytes throws
+ * @c budget_exceeded (a @c std::bad_alloc), and @c try_allocate_bytes returns @c nullptr.
+ *
+ * Budgets nest: a budget with a parent charges both, so per-arena budgets can share a group budget.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Thrown when a memory budget refuses a block.
+     */
+    struct budget_exceeded : std::bad_alloc {
+        const char* what() const noexcept override { return "cma: memory budget exceeded"; }
+    };
+
+    /**
+     * @brief Thread-safe byte budget with a soft and a hard limit, optionally nested in a parent (group) budget.
+     */
+    class memory_budget {
+    public:
+
+        /// @brief Called with the budget and its usage when usage reaches the soft limit.
+        using soft_limit_handler = void (*)(memory_budget& budget, std::size_t used, void* context) noexcept;
+
+        /**
+         * @param hard_limit Bytes never exceeded; charges past it fail.
+         * @param soft_limit Bytes past which the soft limit handler is called (default = the hard limit).
+         * @param parent A group budget charged along with this one, or @c nullptr.
+         */
+        explicit memory_budget(std::size_t hard_limit, std::size_t soft_limit = std::numeric_limits<std::size_t>::max(),
+                               memory_budget* parent = nullptr) noexcept
+            : _hard{hard_limit}
+            , _soft{std::min(soft_limit, hard_limit)}
+            , _parent{parent}
+        {}
+
+        memory_budget(const memory_budget&) = delete;
+
+        memory_budget& operator=(const memory_budget&) = delete;
+
+        /**
+         * @brief Sets the handler called when usage reaches the soft limit.
+         * @note Set before the budget is in use; the handler runs on the allocating thread, before the block
+         *       that crossed the limit is allocated.
+         */
+        void on_soft_limit(soft_limit_handler handler, void* context = nullptr) noexcept {
+            _handler = handler;
+            _context = context;
+        }
+
+        /**
+         * @brief Charges @p bytes to this budget and its parents.
+         * @returns Whether the charge fit under every hard limit (if not, nothing is charged).
+         */
+        bool try_charge(std::size_t bytes) noexcept {
+            std::size_t used {_used.load(std::memory_order_relaxed)};
+            do {
+                if(bytes > _hard || used > _hard - bytes) { return false; }
+            } while(!_used.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+
+            if(_parent && !_parent->try_charge(bytes)) {
+                _used.fetch_sub(bytes, std::memory_order_relaxed);
+                return false;
+            }
+
+            used += bytes;
+            if(used >= _soft && !_tripped.exchange(true, std::memory_order_relaxed) && _handler) {
+                _handler(*this, used, _context);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns @p bytes to this budget and its parents.
+         */
+        void credit(std::size_t bytes) noexcept {
+            if(_used.fetch_sub(bytes, std::memory_order_relaxed) - bytes < _soft) {
+                _tripped.store(false, std::memory_order_relaxed);
+            }
+            if(_parent) { _parent->credit(bytes); }
+        }
+
+        /// @brief Bytes currently charged.
+        std::size_t used() const noexcept { return _used.load(std::memory_order_relaxed); }
+
+        std::size_t hard_limit() const noexcept { return _hard; }
+
+        std::size_t soft_limit() const noexcept { return _soft; }
+
+    private:
+
+        std::size_t _hard;
+
+        std::size_t _soft;
+
+        memory_budget* _parent;
+
+        std::atomic<std::size_t> _used {0};
+
+        /// @brief Whether the handler has run since usage last fell below the soft limit.
+        std::atomic<bool> _tripped {false};
+
+        soft_limit_handler _handler {nullptr};
+
+        void* _context {nullptr};
+    };
+
+    /**
+     * @brief Block source charging every block to a @c memory_budget before drawing it from upstream.
+     * @tparam Upstream The block source storage is drawn from.
+     */
+    template<block_source Upstream = heap_block_source>
+    struct budgeted_block_source {
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        /// @brief The budget blocks are charged to (must outlive the arena); @c nullptr charges nothing.
+        memory_budget* budget {nullptr};
+
+        [[no_unique_address]] Upstream upstream {};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return upstream.round_size(bytes); }
+
+        /**
+         * @brief Charges @p bytes to the budget, then allocates them upstream.
+         * @throws budget_exceeded if the budget refuses the block; whatever the upstream source throws.
+         */
+        void* allocate(std::size_t bytes) {
+            if(!budget) { return upstream.allocate(bytes); }
+            if(!budget->try_charge(bytes)) { throw budget_exceeded{}; }
+
+            try {
+                return upstream.allocate(bytes);
+            } catch (...) {
+                budget->credit(bytes);
+                throw;
+            }
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            upstream.deallocate(p, bytes);
+            if(budget) { budget->credit(bytes); }
+        }
+    };
+
+    /**
+     * @brief Arena whose blocks are charged to a @c memory_budget.
+     */
+    using budgeted_arena = basic_arena<geometric_growth<>, budgeted_block_source<>>;
+
+} // namespace cma
+
+#endif
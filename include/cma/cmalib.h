@@ -30,6 +30,10 @@
 #include <memory_resource>
 #include <type_traits>
 #include <memory>
+#include <limits>
+#include <cstring>
+#include <ranges>
+#include <span>
 
 /*
  * Since this is meant to be exploratory in nature, I will include guarantees and important elements to defining arena allocators.
@@ -188,6 +192,16 @@ namespace cma {
             return reinterpret_cast<std::byte*>(aligned);
         }
 
+        /**
+         * @brief Rounds a size upward to the next multiple of a power-of-two granularity.
+         * @param n The size to round up.
+         * @param granularity The (power-of-two) multiple to round up toward.
+         * @returns The smallest multiple of @c granularity >= @c n (wraps to 0 on overflow).
+         */
+        constexpr std::size_t round_up(std::size_t n, std::size_t granularity) noexcept {
+            return (n + (granularity - 1)) & ~(granularity - 1);
+        }
+
         /**
          * @brief Adds two elements with overflow detection bounded by the first element.
          */
@@ -197,6 +211,30 @@ namespace cma {
             return res < a;
         }
 
+        /**
+         * @brief Entry in an arena's destructor registry, allocated in the arena just before its object(s).
+         */
+        struct dtor_node {
+
+            /// @brief Destroys @c count objects starting at @c object (in reverse order).
+            void (*destroy)(void* object, std::size_t count) noexcept;
+
+            /// @brief The first object to destroy.
+            void* object;
+
+            /// @brief Number of consecutive objects at @c object.
+            std::size_t count;
+
+            /// @brief The previously registered (older) entry.
+            dtor_node* prev;
+        };
+
+        template<typename T>
+        void destroy_reverse(void* object, std::size_t count) noexcept {
+            T* first {static_cast<T*>(object)};
+            while(count) { first[--count].~T(); }
+        }
+
     } // namespace impl
 
     /**
@@ -213,7 +251,7 @@ namespace cma {
         /// @brief Start of raw storage for this block (size = capacity)
         std::byte* data {nullptr};
 
-        /// @brief Next free byte within the block; [data, end].
+        /// @brief Next free byte within the block; [data, end]. Only synchronized once the block is no longer active.
         std::byte* cur  {nullptr};
 
         /// @brief One past the last byte of this block's storage.
@@ -222,22 +260,49 @@ namespace cma {
         /// @brief Next block in the linked-list.
         block* next     {nullptr};
 
-        /// @brief Size of the block's storage in bytes.
+        /// @brief Size of the block's usable storage in bytes (excluding the header).
         std::size_t capacity {0};
 
         /**
-         * @brief Standard constructor for a @c block object.
+         * @brief Bytes reserved for the header at the start of a block's storage.
+         *
+         * The header is placed in the same allocation as the block's data (one allocation and one free per block),
+         * padded such that @c data stays aligned for @c max_align_t.
+         */
+        static constexpr std::size_t header_size() noexcept {
+            return impl::round_up(sizeof(block), alignof(std::max_align_t));
+        }
+
+        /**
+         * @brief Standard constructor for a @c block object, constructed in place at the start of its own storage.
+         * 
+         * The block does not own its storage; the arena obtains and returns it through its block source,
+         * which guarantees that the storage is aligned for @c max_align_t.
          * 
-         * The block is initialized with data aligned to @c max_align_t, ensuring that any normally-aligned
-         * object can be initialized or stored in the block.
-         * %
-         * @param bytes The size of the block to allocate in bytes.
+         * @param bytes The size of the block's storage in bytes, including @c header_size().
          */
-        explicit block(std::size_t bytes)
-            : data{static_cast<std::byte*>(::operator new(bytes))}  // ::operator new returns memory that is aligned for max_align_t
+        explicit block(std::size_t bytes) noexcept
+            : data{reinterpret_cast<std::byte*>(this) + header_size()}
             , cur{data}
-            , end{data + bytes}
-            , capacity{bytes}
+            , end{reinterpret_cast<std::byte*>(this) + bytes}
+            , capacity{bytes - header_size()}
+        {}
+
+        /**
+         * @brief Constructor for a block whose header is allocated apart from its storage.
+         *
+         * Used for over-aligned block sources, where a header inside the storage would cost up to a page (or huge
+         * page) per block: padded in front of the data, or spilling past a page-multiple capacity behind it. The
+         * whole storage is then data, starting at the source's alignment.
+         *
+         * @param storage The start of the block's storage (and data).
+         * @param capacity The size of the block's storage in bytes.
+         */
+        block(std::byte* storage, std::size_t capacity) noexcept
+            : data{storage}
+            , cur{data}
+            , end{data + capacity}
+            , capacity{capacity}
         {}
 
         /**
@@ -250,23 +315,332 @@ namespace cma {
          */
         block& operator=(const block&) = delete;
 
+    };
+
+    /**
+     * @brief A chain of freed blocks handed to a block source as a whole (see @c block_source).
+     */
+    struct block_chain {
+
+        /// @brief The first block, linked to the others through @c block::next.
+        block* head {nullptr};
+
+        /// @brief Combined storage bytes of the blocks, headers included.
+        std::size_t bytes {0};
+
+        /// @brief Whether the headers are allocated apart from the blocks' storage (on the heap).
+        bool detached_headers {false};
+
         /**
-         * @brief Specialized dtor of the @c block object, intended to free all reserved memory at once.
+         * @brief Destroys each block's header and passes its storage to @p f as (storage, bytes).
          */
-        ~block() {
-            ::operator delete(data);
-            data = nullptr;
-            cur = nullptr;
-            end = nullptr;
-            capacity = 0;
+        template<typename F>
+        void for_each_storage(F&& f) const noexcept {
+            const std::size_t header {detached_headers ? 0 : block::header_size()};
+
+            for(block* b {head}; b;) {
+                block* next {b->next};
+                const std::size_t size {b->capacity + header};
+                void* storage {detached_headers ? static_cast<void*>(b->data) : static_cast<void*>(b)};
+
+                if(detached_headers) { delete b; } else { b->~block(); }
+                f(storage, size);
+                b = next;
+            }
         }
+    };
 
+    /**
+     * @brief Concept denoting a provider of raw block storage for an arena.
+     *
+     * @details
+     * A block source hands out storage aligned for at least @c max_align_t. @c round_size lets the source
+     * grow a requested capacity to its natural granularity (pages, huge pages, ...), and the arena always
+     * requests rounded sizes, returning storage with the same size it was allocated with.
+     *
+     * A source may declare a stronger base alignment with a static @c alignment member; its rounded sizes
+     * must then be multiples of @c alignof(block).
+     *
+     * A source may also prepare blocks ahead of need: with a @c prepare(bytes) member and a static @c fill_percent,
+     * the arena calls @c prepare with the size of the block it will most likely allocate next once the last block
+     * is @c fill_percent full (see @c async_block_source).
+     *
+     * And a source may take over freed blocks in bulk: with a noexcept @c deallocate_chain(block_chain) member,
+     * the arena hands over all the blocks it frees at once in a single call (see @c deferred_block_source).
+     *
+     * Finally, a source with a noexcept @c decommit(p, bytes) member can return the physical pages under a range
+     * of an empty block to the system while the block (and its address range) stays allocated; this enables
+     * @c basic_arena::trim (see @c decommit_block_source).
+     */
+    template<typename S>
+    concept block_source = requires(S& s, std::size_t n, void* p) {
+        { s.round_size(n) } -> std::convertible_to<std::size_t>;
+        { s.allocate(n) } -> std::same_as<void*>;
+        { s.deallocate(p, n) } noexcept;
+    };
+
+    namespace impl {
+
+        /**
+         * @brief The base alignment of the storage handed out by a block source.
+         */
+        template<typename S>
+        constexpr std::size_t block_alignment() noexcept {
+            if constexpr (requires { { S::alignment } -> std::convertible_to<std::size_t>; }) {
+                return std::max<std::size_t>(S::alignment, alignof(std::max_align_t));
+            } else {
+                return alignof(std::max_align_t);
+            }
+        }
+
+    } // namespace impl
+
+    /**
+     * @brief Default block source, backed by the global @c ::operator new.
+     */
+    struct heap_block_source {
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return bytes; }
+
+        void* allocate(std::size_t bytes) {
+            return ::operator new(bytes);   // ::operator new returns memory that is aligned for max_align_t
+        }
+
+        void deallocate(void* p, std::size_t) noexcept {
+            ::operator delete(p);
+        }
+    };
+
+    /**
+     * @brief Block source backed by the aligned global @c ::operator new, for over-aligned block bases.
+     * @tparam Alignment The base alignment of every block (e.g. 64 for cache lines, 4096 for pages).
+     */
+    template<std::size_t Alignment>
+    struct aligned_block_source {
+        static_assert(impl::is_pow_2(Alignment) && Alignment >= alignof(std::max_align_t),
+                      "Alignment must be a power of two, at least alignof(std::max_align_t)!");
+
+        /// @brief Base alignment of every block's storage.
+        static constexpr std::size_t alignment {Alignment};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return impl::round_up(bytes, Alignment); }
+
+        void* allocate(std::size_t bytes) {
+            return ::operator new(bytes, std::align_val_t{Alignment});
+        }
+
+        void deallocate(void* p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t{Alignment});
+        }
+    };
+
+    /**
+     * @brief Concept denoting a policy choosing the capacity of each new block.
+     *
+     * @details
+     * @c next_capacity receives the capacity of the active block, the bytes needed by the allocation that
+     * triggered growth (including alignment slack) and the arena's minimum block size. The result must be
+     * >= @c need. A policy may also provide @c on_reset(peak_bytes_in_use), invoked by @c reset() and @c release(),
+     * and @c set_header_bytes(bytes), invoked once at construction with the bytes of each block's storage taken
+     * by its header (see @c basic_arena::header_bytes).
+     */
+    template<typename P>
+    concept growth_policy = requires(P& p, std::size_t n) {
+        { p.next_capacity(n, n, n) } -> std::convertible_to<std::size_t>;
+    };
+
+    /**
+     * @brief Grows each block by a constant factor of the active block, optionally capped.
+     * @tparam Factor The multiple of the active block's capacity (default = 2).
+     * @tparam Cap The largest capacity grown to, unless a single allocation needs more (default = unbounded).
+     */
+    template<std::size_t Factor = 2, std::size_t Cap = std::numeric_limits<std::size_t>::max()>
+    struct geometric_growth {
+        static_assert(Factor >= 1, "Factor must be at least 1!");
+
+        constexpr std::size_t next_capacity(std::size_t active, std::size_t need, std::size_t min_block) const noexcept {
+            const std::size_t grown {std::min(active * Factor, Cap)};
+            return std::max(std::max(grown, need), min_block);
+        }
+    };
+
+    /**
+     * @brief Every block is the arena's minimum block size, unless a single allocation needs more.
+     */
+    struct fixed_growth {
+        constexpr std::size_t next_capacity(std::size_t, std::size_t need, std::size_t min_block) const noexcept {
+            return std::max(need, min_block);
+        }
+    };
+
+    /**
+     * @brief Rounds another policy's choice such that a whole block (header, if stored in it, included) spans full
+     *        pages.
+     * @tparam Inner The policy being rounded.
+     * @tparam Granularity The (power-of-two) page size to round to; use 2 MiB / 1 GiB for huge pages.
+     */
+    template<growth_policy Inner = geometric_growth<>, std::size_t Granularity = 4096>
+    struct page_rounded_growth {
+        static_assert(impl::is_pow_2(Granularity), "Granularity must be a power of two!");
+
+        [[no_unique_address]] Inner inner {};
+
+        /// @brief Bytes of each block's storage taken by its header (set by the arena).
+        std::size_t header_bytes {block::header_size()};
+
+        constexpr std::size_t next_capacity(std::size_t active, std::size_t need, std::size_t min_block) noexcept {
+            const std::size_t cap {inner.next_capacity(active, need, min_block)};
+            const std::size_t rounded {impl::round_up(cap + header_bytes, Granularity) - header_bytes};
+            return rounded < cap ? cap : rounded;
+        }
+
+        void on_reset(std::size_t in_use) noexcept {
+            if constexpr (requires { inner.on_reset(in_use); }) { inner.on_reset(in_use); }
+        }
+
+        void set_header_bytes(std::size_t bytes) noexcept {
+            header_bytes = bytes;
+            if constexpr (requires { inner.set_header_bytes(bytes); }) { inner.set_header_bytes(bytes); }
+        }
+    };
+
+    /**
+     * @brief Sizes new blocks from the peak bytes in use of the cycle ended by the last @c reset()/@c release().
+     *
+     * The first block grown in a cycle is large enough to hold the most the previous cycle held at once (rolled
+     * back scopes and freed top allocations included), so a repeated workload settles into a single growth step
+     * per cycle (none, once blocks are retained).
+     *
+     * @tparam Inner The policy used until a cycle has been observed, and whenever it asks for more.
+     */
+    template<growth_policy Inner = geometric_growth<>>
+    struct learned_growth {
+
+        [[no_unique_address]] Inner inner {};
+
+        /// @brief Peak bytes in use of the previous cycle.
+        std::size_t high_water {0};
+
+        constexpr std::size_t next_capacity(std::size_t active, std::size_t need, std::size_t min_block) noexcept {
+            return std::max(inner.next_capacity(active, need, min_block), high_water);
+        }
+
+        void on_reset(std::size_t in_use) noexcept {
+            high_water = in_use;
+            if constexpr (requires { inner.on_reset(in_use); }) { inner.on_reset(in_use); }
+        }
+
+        void set_header_bytes(std::size_t bytes) noexcept {
+            if constexpr (requires { inner.set_header_bytes(bytes); }) { inner.set_header_bytes(bytes); }
+        }
+    };
+
+    /**
+     * @brief Snapshot of an arena's counters (see @c counting_stats).
+     */
+    struct arena_stats {
+
+        /// @brief Successful @c allocate_bytes calls (factories included).
+        std::size_t allocations {0};
+
+        /// @brief Bytes asked for by those calls.
+        std::size_t bytes_requested {0};
+
+        /// @brief Bytes skipped by aligning the cursor; consumed = requested + padding.
+        std::size_t padding_bytes {0};
+
+        /// @brief Bytes left unused at the end of a block when the arena moved on to the next one.
+        std::size_t abandoned_bytes {0};
+
+        /// @brief Blocks drawn from the block source (the first block included).
+        std::size_t blocks_allocated {0};
+
+        /// @brief Bytes of block storage currently held (headers included).
+        std::size_t footprint_bytes {0};
+
+        /// @brief Largest @c footprint_bytes seen.
+        std::size_t peak_footprint_bytes {0};
+
+        /// @brief Deallocations received through @c cma_resource or @c cma_allocator.
+        std::size_t deallocations {0};
+
+        /// @brief Bytes passed to those deallocations.
+        std::size_t bytes_deallocated {0};
+
+        /// @brief Bytes of those deallocations actually returned to the arena (top allocations).
+        std::size_t bytes_reclaimed {0};
+    };
+
+    /**
+     * @brief Concept denoting an arena statistics policy.
+     *
+     * @details
+     * The arena reports each event to its policy; a policy that ignores them (@c no_stats) compiles away entirely.
+     * Policies offering @c snapshot() enable @c basic_arena::snapshot().
+     */
+    template<typename S>
+    concept stats_policy = requires(S& s, std::size_t n, bool b) {
+        s.on_allocate(n, n);
+        s.on_deallocate(n, b);
+        s.on_abandon(n);
+        s.on_block_allocated(n);
+        s.on_block_freed(n);
+    };
+
+    /**
+     * @brief Default statistics policy: records nothing.
+     */
+    struct no_stats {
+        constexpr void on_allocate(std::size_t, std::size_t) noexcept {}
+        constexpr void on_deallocate(std::size_t, bool) noexcept {}
+        constexpr void on_abandon(std::size_t) noexcept {}
+        constexpr void on_block_allocated(std::size_t) noexcept {}
+        constexpr void on_block_freed(std::size_t) noexcept {}
+    };
+
+    /**
+     * @brief Statistics policy keeping plain (single-threaded) counters, as the arena itself is.
+     */
+    struct counting_stats {
+
+        void on_allocate(std::size_t bytes, std::size_t padding) noexcept {
+            ++_s.allocations;
+            _s.bytes_requested += bytes;
+            _s.padding_bytes += padding;
+        }
+
+        void on_deallocate(std::size_t bytes, bool reclaimed) noexcept {
+            ++_s.deallocations;
+            _s.bytes_deallocated += bytes;
+            if(reclaimed) { _s.bytes_reclaimed += bytes; }
+        }
+
+        void on_abandon(std::size_t bytes) noexcept { _s.abandoned_bytes += bytes; }
+
+        void on_block_allocated(std::size_t bytes) noexcept {
+            ++_s.blocks_allocated;
+            _s.footprint_bytes += bytes;
+            _s.peak_footprint_bytes = std::max(_s.peak_footprint_bytes, _s.footprint_bytes);
+        }
+
+        void on_block_freed(std::size_t bytes) noexcept { _s.footprint_bytes -= bytes; }
+
+        arena_stats snapshot() const noexcept { return _s; }
+
+    private:
+
+        arena_stats _s {};
     };
 
     /**
      * @brief Main memory handling class, utilizing linked memory blocks.
+     * @tparam GrowthPolicy The policy choosing the capacity of new blocks (default = @c geometric_growth<>).
+     * @tparam BlockSource The provider of raw storage for each block (default = @c heap_block_source).
+     * @tparam StatsPolicy The recorder of allocation statistics (default = @c no_stats, compiled out).
      */
-    class arena {
+    template<growth_policy GrowthPolicy = geometric_growth<>, block_source BlockSource = heap_block_source,
+             stats_policy StatsPolicy = no_stats>
+    class basic_arena {
     public:
 
         /**
@@ -275,23 +649,36 @@ namespace cma {
         struct marker {
             block* mem    {nullptr};
             std::byte* cur  {nullptr};
+            impl::dtor_node* dtors {nullptr};
+
+            /// @brief Bytes in use in, and extent of, the blocks before @c mem.
+            std::size_t used_before {0};
+            std::size_t extent_before {0};
         };
 
         /**
          * @brief Explicit ctor for an arena with an initial size per block.
          * @param initial_block_size The initial size of each memory block in the arena.
+         * @param source The block source to draw storage from.
+         * @param growth The growth policy instance (for stateful policies).
          */
-        explicit arena(std::size_t initial_block_size = 64 * 1024)
-            : _block_size{std::max<std::size_t>(initial_block_size, 1024)}
-            , _head{new block(_block_size)}
-            , _active{_head}
-        {}
+        explicit basic_arena(std::size_t initial_block_size = 64 * 1024, BlockSource source = {}, GrowthPolicy growth = {})
+            : _source{std::move(source)}
+            , _growth{with_header_bytes(std::move(growth))}
+            , _block_size{std::max<std::size_t>(initial_block_size, 1024)}
+            , _head{new_block(_block_size)}
+        {
+            activate(_head);
+        }
 
-        arena(const arena&) = delete;
+        basic_arena(const basic_arena&) = delete;
 
-        arena& operator=(const arena&) = delete;
+        basic_arena& operator=(const basic_arena&) = delete;
 
-        ~arena() { free_all(); }
+        ~basic_arena() {
+            run_dtors_until(nullptr);
+            free_all();
+        }
 
         /**
          * @brief Main function to allocate bytes in a memory arena.
@@ -309,50 +696,280 @@ namespace cma {
             // Attempt current block
             if(void* p {try_alloc_at_active(bytes, alignment)}) { return p; }
 
-            // Otherwise a new block is needed...
-            std::size_t need {0};
-            if(impl::overflow_addition(bytes, alignment, need)) { throw std::bad_alloc{}; }
+            // Crossing the fill threshold (see end_of) only asks the source for the next block; the rest of
+            // the active block is still used.
+            if(void* p {try_alloc_past_threshold(bytes, alignment)}) { return p; }
 
-            // Resizing policy dictates that we double our current capacity.
-            std::size_t new_cap {std::max(_active->capacity * 2, need)};
-            new_cap = std::max(new_cap, _block_size);
+            // Otherwise a new block is needed; its data is aligned to the base alignment, so only stronger
+            // alignments need slack for padding.
+            std::size_t need {bytes};
+            if(alignment > base_alignment && impl::overflow_addition(bytes, alignment - base_alignment, need)) {
+                throw std::bad_alloc{};
+            }
 
-            auto* b {new block(new_cap)};
-            b->next = nullptr;
+            // Whatever the active block has left is skipped from here on.
+            _stats.on_abandon(static_cast<std::size_t>(_end - _cur));
+
+            // Blocks past the active one are empty (see rollback_to), so reuse the first that fits before growing.
+            for(block* b {_active->next}; b; b = b->next) {
+                if(need <= b->capacity) {
+                    activate(b);
+                    if(void* p {try_alloc_at_active(bytes, alignment)}) { return p; }
+                    return try_alloc_past_threshold(bytes, alignment);
+                }
+            }
+
+            // The growth policy dictates the new capacity (by default, double our current capacity).
+            const std::size_t new_cap {_growth.next_capacity(_active->capacity, need, _block_size)};
+
+            // The new block is spliced in after the active one, keeping any (too small) empty blocks reachable.
+            auto* b {new_block(new_cap)};
+            b->next = _active->next;
             _active->next = b;
-            _active = b;
+            activate(b);
 
             if(void* p {try_alloc_at_active(bytes, alignment)}) { return p; }
+            if(void* p {try_alloc_past_threshold(bytes, alignment)}) { return p; }
 
             throw std::bad_alloc{}; //This should be virtually impossible...
         }
 
+        /**
+         * @brief Like @c allocate_bytes, but reports failure (no memory, or a budget refusing a block; see
+         *        @c budgeted_block_source) by returning @c nullptr.
+         */
+        void* try_allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+            try {
+                return allocate_bytes(bytes, alignment);
+            } catch (const std::bad_alloc&) {
+                return nullptr;
+            }
+        }
+
+        /**
+         * @brief Grows the most recent allocation in place, without moving it.
+         * @param p The most recent allocation.
+         * @param old_size The size @p p was allocated (or last resized) with.
+         * @param new_size The requested size (>= @p old_size).
+         * @returns Whether @p p now spans @p new_size bytes; fails if @p p is not the most recent allocation
+         *          or the active block lacks room, leaving the arena unchanged.
+         */
+        bool try_extend(void* p, std::size_t old_size, std::size_t new_size) noexcept {
+            auto* b {static_cast<std::byte*>(p)};
+            if(!is_top(b, old_size) || new_size < old_size) { return false; }
+            if(static_cast<std::size_t>(_active->end - b) < new_size) { return false; }
+
+            _cur = b + new_size;
+            return true;
+        }
+
+        /**
+         * @brief Shrinks the most recent allocation in place, returning the tail to the arena.
+         * @param p The most recent allocation.
+         * @param old_size The size @p p was allocated (or last resized) with.
+         * @param new_size The requested size (<= @p old_size); 0 reclaims the allocation entirely.
+         * @returns Whether the tail was reclaimed; fails if @p p is not the most recent allocation.
+         */
+        bool try_shrink(void* p, std::size_t old_size, std::size_t new_size) noexcept {
+            auto* b {static_cast<std::byte*>(p)};
+            if(!is_top(b, old_size) || new_size > old_size) { return false; }
+
+            note_peak();
+            _cur = b + new_size;
+            return true;
+        }
+
         /**
          * @brief Creates a marker at the current active block and byte.
          * @returns The marker at the specified location.
          */
         marker create_marker() const noexcept {
-            return marker{_active, _active ? _active->cur : nullptr};
+            return marker{_active, _cur, _dtors, _used_before, _extent_before};
         }
 
         /**
          * @brief Reverts the state of the allocation in the arena to a given marker.
          * @param m The marker to revert to.
-         * @note This is mainly used to avoid UB with failed/bad allocs.
+         * @note This is mainly used to avoid UB with failed/bad allocs. Blocks after the marker are kept
+         *       (emptied) and reused by later allocations rather than returned to the system. Objects made
+         *       after the marker are destroyed (newest first).
          */
         void rollback_to(const marker& m) noexcept {
             if (!m.mem) { return; }
 
+            run_dtors_until(m.dtors);
+            note_peak();
+
             _active = m.mem;
-            _active->cur = m.cur;
+            _cur = m.cur;
+            _end = end_of(_active);
+            _used_before = m.used_before;
+            _extent_before = m.extent_before;
 
             for(auto* b {_active->next}; b; b = b->next) {
                 b->cur = b->data;
             }
         }
 
+        /**
+         * @brief Rewinds every block in the arena while retaining all of them for reuse.
+         *
+         * Equivalent to rolling back to a marker taken right after construction; no memory is returned to
+         * the system, so an arena cycled with @c reset() reaches a steady state with no system allocations.
+         * All objects made in the arena are destroyed (newest first).
+         */
+        void reset() noexcept {
+            run_dtors_until(nullptr);
+
+            if constexpr (requires(std::size_t n) { _growth.on_reset(n); }) {
+                _growth.on_reset(peak_bytes_in_use());
+            }
+
+            rewind();
+        }
+
+        /**
+         * @brief Rewinds the arena and frees blocks beyond a retained byte budget.
+         *
+         * The head block is always kept. Following blocks are kept (in chain order) as long as their combined
+         * capacity fits within @p retained_bytes, all others are returned to the system.
+         *
+         * @param retained_bytes Capacity budget for blocks kept in addition to the head (default = head only).
+         */
+        void release(std::size_t retained_bytes = 0) noexcept {
+            run_dtors_until(nullptr);
+
+            if constexpr (requires(std::size_t n) { _growth.on_reset(n); }) {
+                _growth.on_reset(peak_bytes_in_use());
+            }
+
+            std::size_t kept {0};
+            block* tail {_head};
+
+            // Sources taking blocks in bulk get the dropped ones as a single chain.
+            block* dropped {nullptr};
+            std::size_t dropped_bytes {0};
+
+            for(auto* b {_head->next}; b;) {
+                block* next {b->next};
+
+                if(b->capacity <= retained_bytes - kept) {
+                    kept += b->capacity;
+                    tail->next = b;
+                    tail = b;
+                } else if constexpr (releases_chains) {
+                    b->next = dropped;
+                    dropped = b;
+                    dropped_bytes += b->capacity + header_bytes;
+                } else {
+                    delete_block(b);
+                }
+
+                b = next;
+            }
+
+            tail->next = nullptr;
+            if constexpr (releases_chains) { release_chain(dropped, dropped_bytes); }
+            rewind();
+        }
+
+        /**
+         * @brief Resets the arena and returns the physical pages beyond its first @p retained_bytes to the system.
+         *
+         * Unlike @c release(), every block is kept: only the pages under block data past @p retained_bytes (counted
+         * in chain order, as by @c extent_bytes()) are decommitted, so the address space stays reserved and a later
+         * cycle reaching that far refaults zeroed (or, with lazy advice, possibly still intact) pages instead of
+         * allocating blocks. Pair with a hysteresis over recent high-water marks (see @c trim_hysteresis and
+         * @c peak_extent_bytes) so a single quiet cycle does not give up pages the next busy one needs.
+         *
+         * @param retained_bytes Bytes of block data whose pages are kept.
+         */
+        void trim(std::size_t retained_bytes) noexcept requires decommits_blocks {
+            reset();
+
+            std::size_t kept {0};
+            for(auto* b {_head}; b; b = b->next) {
+                const std::size_t keep {std::min(b->capacity, retained_bytes - kept)};
+                if(keep < b->capacity) { _source.decommit(b->data + keep, b->capacity - keep); }
+                kept += keep;
+            }
+        }
+
+        /**
+         * @brief Creates the next @p count blocks the growth policy would choose, ahead of need.
+         *
+         * The blocks are chained (empty) after the last block, where the slow path picks them up instead of
+         * allocating; with a pre-faulting block source (see @c prefault_block_source) their pages are faulted in
+         * here too, so calling this at construction keeps block creation and page faults off the hot path.
+         *
+         * @param count The number of blocks to create.
+         * @throws std::bad_alloc if a block cannot be allocated (blocks created so far are kept).
+         */
+        void reserve_blocks(std::size_t count) {
+            block* tail {_active};
+            while(tail->next) { tail = tail->next; }
+
+            for(; count; --count) {
+                block* b {new_block(_growth.next_capacity(tail->capacity, 0, _block_size))};
+                tail->next = b;
+                tail = b;
+            }
+        }
+
+        /**
+         * @brief Sums the bytes handed out (padding included) across the blocks up to the active one.
+         */
+        std::size_t bytes_in_use() const noexcept {
+            return _used_before + static_cast<std::size_t>(_cur - _active->data);
+        }
+
+        /**
+         * @brief The most @c bytes_in_use() since the last @c reset(), @c release() or @c trim(), rolled back
+         *        or shrunk allocations included: the cycle's high-water mark.
+         */
+        std::size_t peak_bytes_in_use() const noexcept { return std::max(_peak_in_use, bytes_in_use()); }
+
+        /**
+         * @brief Bytes of block data before the cursor, in chain order: @c bytes_in_use() plus the tails skipped
+         *        at the end of earlier blocks.
+         */
+        std::size_t extent_bytes() const noexcept {
+            return _extent_before + static_cast<std::size_t>(_cur - _active->data);
+        }
+
+        /**
+         * @brief The furthest @c extent_bytes() reached since the last @c reset(), @c release() or @c trim(),
+         *        rolled back or shrunk allocations included: the cycle's high-water mark.
+         */
+        std::size_t peak_extent_bytes() const noexcept { return std::max(_peak_extent, extent_bytes()); }
+
+        /**
+         * @brief Storage bytes of every block the arena holds, headers included.
+         */
+        std::size_t footprint_bytes() const noexcept { return _footprint; }
+
+        /**
+         * @brief Copies the arena's counters; only available with a counting @c StatsPolicy.
+         */
+        arena_stats snapshot() const noexcept requires requires(const StatsPolicy& s) { s.snapshot(); } {
+            return _stats.snapshot();
+        }
+
+        /**
+         * @brief The arena's statistics policy, through which adaptors report deallocations.
+         */
+        StatsPolicy& stats() noexcept { return _stats; }
+
+        /// @brief The arena's block source.
+        const BlockSource& source() const noexcept { return _source; }
+
         /**
          * @brief Arena object factory
+         * 
+         * Objects that are not trivially destructible are registered (with a small node allocated alongside
+         * them) so their destructor runs on @c reset(), @c release(), @c rollback_to() past them, and the
+         * destruction of the arena. Trivially destructible types pay nothing for this.
+         * 
          * @tparam T The type to construct in the arena
          * @tparam Args The constructor arg types to forward
          * @param args The arguments to forward for construction
@@ -363,28 +980,151 @@ namespace cma {
             static_assert(!std::is_void_v<T>, "T cannot be void!");
 
             const marker m {create_marker()};
+            void* node {nullptr};
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                node = allocate_bytes(sizeof(impl::dtor_node), alignof(impl::dtor_node));
+            }
             void* memory {allocate_bytes(sizeof(T), alignof(T))};
 
             try {
-                return ::new (memory) T(std::forward<Args>(args)...);
+                T* object {::new (memory) T(std::forward<Args>(args)...)};
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    _dtors = ::new (node) impl::dtor_node{&impl::destroy_reverse<T>, object, 1, _dtors};
+                }
+                return object;
             } catch (...) {
                 rollback_to(m);
                 throw;
             }
         }
 
+        /**
+         * @brief Constructs @p n value-initialized objects in one contiguous allocation.
+         * @tparam T The element type.
+         * @param n The number of elements.
+         * @returns The constructed elements (empty if @p n is 0).
+         * @throws std::bad_alloc if @p n * sizeof(T) overflows; anything thrown by T's constructor.
+         */
+        template<typename T>
+        std::span<T> make_array(std::size_t n) {
+            return make_n<T>(n, [n](T* first) { std::uninitialized_value_construct_n(first, n); });
+        }
+
+        /**
+         * @brief Constructs @p n copies of @p value in one contiguous allocation.
+         * @note For trivially copyable @c T this is a @c memset when every byte of @p value is the same.
+         */
+        template<typename T>
+        std::span<T> make_array(std::size_t n, const T& value) {
+            return make_n<T>(n, [n, &value](T* first) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    const auto* bytes {reinterpret_cast<const unsigned char*>(std::addressof(value))};
+                    if(std::all_of(bytes, bytes + sizeof(T), [&](unsigned char b) { return b == bytes[0]; })) {
+                        std::memset(first, bytes[0], n * sizeof(T));
+                        return;
+                    }
+                }
+                std::uninitialized_fill_n(first, n, value);
+            });
+        }
+
+        /**
+         * @brief Constructs @p n default-initialized objects (indeterminate values for trivial types).
+         */
+        template<typename T>
+        std::span<T> make_uninitialized_array(std::size_t n) {
+            return make_n<T>(n, [n](T* first) { std::uninitialized_default_construct_n(first, n); });
+        }
+
+        /**
+         * @brief Copies a sized range into one contiguous allocation.
+         * @note For trivially copyable elements of a contiguous range this is a @c memcpy.
+         */
+        template<std::ranges::sized_range R, typename T = std::ranges::range_value_t<R>>
+        std::span<T> make_span(R&& range) {
+            const auto n {static_cast<std::size_t>(std::ranges::size(range))};
+
+            return make_n<T>(n, [n, &range](T* first) {
+                if constexpr (std::ranges::contiguous_range<R> && std::is_trivially_copyable_v<T>
+                              && std::is_same_v<std::remove_cv_t<std::ranges::range_value_t<R>>, T>) {
+                    std::memcpy(first, std::ranges::data(range), n * sizeof(T));
+                } else {
+                    std::ranges::uninitialized_copy_n(std::ranges::begin(range), static_cast<std::ptrdiff_t>(n), first, first + n);
+                }
+            });
+        }
+
+
+        /// @brief Alignment of every block's data (the block source's base alignment).
+        static constexpr std::size_t base_alignment {impl::block_alignment<BlockSource>()};
+
+        /// @brief Over-aligned sources keep their alignment (and page-multiple sizes) for the data by allocating
+        ///        block headers apart from the storage.
+        static constexpr bool detached_header {base_alignment > alignof(std::max_align_t)};
+
+        /// @brief Bytes of each block's storage taken by its header.
+        static constexpr std::size_t header_bytes {detached_header ? 0 : block::header_size()};
 
     private:
 
+        /// @brief Whether the block source prepares blocks ahead of need (see @c block_source).
+        static constexpr bool prepares_blocks {requires(BlockSource& s, std::size_t n) {
+            s.prepare(n);
+            { BlockSource::fill_percent } -> std::convertible_to<std::size_t>;
+        }};
+
+        /// @brief Whether the block source takes freed blocks in bulk (see @c block_source).
+        static constexpr bool releases_chains {requires(BlockSource& s, const block_chain& c) {
+            { s.deallocate_chain(c) } noexcept;
+        }};
+
+        /// @brief Whether the block source can drop the pages of empty blocks (see @c block_source).
+        static constexpr bool decommits_blocks {requires(BlockSource& s, void* p, std::size_t n) {
+            { s.decommit(p, n) } noexcept;
+        }};
+
+        /// @brief The provider of block storage.
+        [[no_unique_address]] BlockSource _source;
+
+        /// @brief The policy sizing new blocks.
+        [[no_unique_address]] GrowthPolicy _growth;
+
+        /// @brief The recorder of allocation statistics.
+        [[no_unique_address]] StatsPolicy _stats;
+
         /// @brief The size blocks stored in the arena.
         std::size_t _block_size {0};
 
+        /// @brief Storage bytes of every block, headers included (declared before @c _head, which adds to it).
+        std::size_t _footprint {0};
+
         /// @brief The head block of the arena.
         block* _head    {nullptr};
 
         /// @brief The currently used block in the arena.
         block* _active  {nullptr};
 
+        /// @brief Next free byte of the active block (cached here so the fast path does not chase @c _active).
+        std::byte* _cur {nullptr};
+
+        /// @brief One past the last byte of the active block.
+        std::byte* _end {nullptr};
+
+        /// @brief Newest entry of the destructor registry (an intrusive list stored in the arena itself).
+        impl::dtor_node* _dtors {nullptr};
+
+        /// @brief Bytes in use in the blocks before the active one (kept so @c bytes_in_use() is O(1)).
+        std::size_t _used_before {0};
+
+        /// @brief Capacity of the blocks before the active one (kept so @c extent_bytes() is O(1)).
+        std::size_t _extent_before {0};
+
+        /// @brief Most bytes in use retreated from in the current cycle (see @c peak_bytes_in_use).
+        std::size_t _peak_in_use {0};
+
+        /// @brief Furthest extent retreated from in the current cycle (see @c peak_extent_bytes).
+        std::size_t _peak_extent {0};
+
         /**
          * @brief Releases all held memory back to the OS.
          * 
@@ -392,18 +1132,189 @@ namespace cma {
          * avoiding induvidual releases.
          */
         void free_all() noexcept {
-            block* curr {_head};
-
-            while(curr) {
-                block* next {curr->next};
-                delete curr;
-                curr = next;
+            if constexpr (releases_chains) {
+                release_chain(_head, _footprint);
+            } else {
+                block* curr {_head};
+
+                while(curr) {
+                    block* next {curr->next};
+                    delete_block(curr);
+                    curr = next;
+                }
             }
 
             _head = nullptr;
             _active = nullptr;
         }
 
+        /**
+         * @brief Hands a chain of blocks spanning @p bytes of storage to the block source in one call.
+         */
+        void release_chain(block* head, std::size_t bytes) noexcept {
+            if(!head) { return; }
+
+            _source.deallocate_chain(block_chain{head, bytes, detached_header});
+            _footprint -= bytes;
+            _stats.on_block_freed(bytes);
+        }
+
+        /**
+         * @brief Tells the growth policy how much of each block's storage its header takes, if it asks.
+         */
+        static GrowthPolicy with_header_bytes(GrowthPolicy growth) noexcept {
+            if constexpr (requires(std::size_t n) { growth.set_header_bytes(n); }) { growth.set_header_bytes(header_bytes); }
+            return growth;
+        }
+
+        /**
+         * @brief Creates a block, with its header and data in a single allocation drawn from the block source (or,
+         *        for over-aligned sources, its header on the heap; see @c detached_header).
+         * @param capacity The minimum usable capacity of the block (rounded up by the block source).
+         */
+        block* new_block(std::size_t capacity) {
+            std::size_t bytes {0};
+            if(impl::overflow_addition(capacity, header_bytes, bytes)) { throw std::bad_alloc{}; }
+
+            bytes = _source.round_size(bytes);
+            if(bytes < header_bytes + capacity) { throw std::bad_alloc{}; }
+
+            auto* storage {static_cast<std::byte*>(_source.allocate(bytes))};
+            block* b {nullptr};
+
+            if constexpr (detached_header) {
+                try {
+                    b = new block(storage, bytes);
+                } catch (...) {
+                    _source.deallocate(storage, bytes);
+                    throw;
+                }
+            } else {
+                b = ::new (storage) block(bytes);
+            }
+
+            _footprint += bytes;
+            _stats.on_block_allocated(bytes);
+            return b;
+        }
+
+        /**
+         * @brief Returns a block's storage (header included) to the block source.
+         */
+        void delete_block(block* b) noexcept {
+            const std::size_t bytes {b->capacity + header_bytes};
+            void* storage {detached_header ? static_cast<void*>(b->data) : static_cast<void*>(b)};
+
+            if constexpr (detached_header) { delete b; } else { b->~block(); }
+            _source.deallocate(storage, bytes);
+            _footprint -= bytes;
+            _stats.on_block_freed(bytes);
+        }
+
+        /**
+         * @brief Shared implementation of the array factories: one overflow-checked bump for @p n elements,
+         *        constructed by @p init, rolled back as a whole on exceptions.
+         */
+        template<typename T, typename Init>
+        std::span<T> make_n(std::size_t n, Init&& init) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+
+            if(n == 0) { return {}; }
+            if(n > std::numeric_limits<std::size_t>::max() / sizeof(T)) { throw std::bad_alloc{}; }
+
+            const marker m {create_marker()};
+            void* node {nullptr};
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                node = allocate_bytes(sizeof(impl::dtor_node), alignof(impl::dtor_node));
+            }
+            T* first {static_cast<T*>(allocate_bytes(n * sizeof(T), alignof(T)))};
+
+            try {
+                init(first);    // the uninitialized algorithms destroy any partial construction themselves
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    _dtors = ::new (node) impl::dtor_node{&impl::destroy_reverse<T>, first, n, _dtors};
+                }
+                return {first, n};
+            } catch (...) {
+                rollback_to(m);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Runs registered destructors, newest first, until reaching @p stop.
+         */
+        void run_dtors_until(impl::dtor_node* stop) noexcept {
+            while(_dtors != stop) {
+                impl::dtor_node* n {_dtors};
+                _dtors = n->prev;
+                n->destroy(n->object, n->count);
+            }
+        }
+
+        /**
+         * @brief Records the current usage and extent if they are the cycle's largest, before a rollback or shrink
+         *        retreats from them.
+         */
+        void note_peak() noexcept {
+            _peak_in_use = std::max(_peak_in_use, bytes_in_use());
+            _peak_extent = std::max(_peak_extent, extent_bytes());
+        }
+
+        /**
+         * @brief Empties every block and makes the head active (starting a new cycle).
+         */
+        void rewind() noexcept {
+            for(auto* b {_head}; b; b = b->next) {
+                b->cur = b->data;
+            }
+
+            _peak_in_use = 0;
+            _peak_extent = 0;
+            _used_before = 0;
+            _extent_before = 0;
+
+            _active = _head;
+            _cur = _head->cur;
+            _end = end_of(_head);
+        }
+
+        /**
+         * @brief Whether [p, p + size) is the most recent allocation in the active block.
+         */
+        bool is_top(std::byte* p, std::size_t size) const noexcept {
+            return p >= _active->data && p <= _cur && static_cast<std::size_t>(_cur - p) == size;
+        }
+
+        /**
+         * @brief Makes @p b (the active block, or an empty one past it) the active block, syncing the cached cursor
+         *        back to the previously active one.
+         */
+        void activate(block* b) noexcept {
+            if(_active) {
+                _active->cur = _cur;
+                _used_before += static_cast<std::size_t>(_cur - _active->data);
+
+                // Blocks skipped on the way are empty, and add only their capacity to the extent.
+                for(block* s {_active}; s != b; s = s->next) { _extent_before += s->capacity; }
+            }
+
+            _active = b;
+            _cur = b->cur;
+            _end = end_of(b);
+        }
+
+        /**
+         * @brief The end the fast path bumps toward in @p b: its real end, or its fill threshold when @p b is the
+         *        last block and the block source prepares blocks ahead of need.
+         */
+        std::byte* end_of(block* b) const noexcept {
+            if constexpr (prepares_blocks) {
+                if(!b->next) { return b->data + b->capacity / 100 * BlockSource::fill_percent; }
+            }
+            return b->end;
+        }
+
         /**
          * @brief Attempts to make an allocation at the currently active block in the arena.
          * @param bytes The number of bytes to allocate.
@@ -411,21 +1322,59 @@ namespace cma {
          * @returns The address of the allocated memory (raw storage).
          */
         void* try_alloc_at_active(std::size_t bytes, std::size_t alignment) noexcept {
-            std::byte* aligned {impl::align_up(_active->cur, alignment)};
+            std::byte* aligned {impl::align_up(_cur, alignment)};
 
-            if(static_cast<std::size_t>(_active->end - aligned) < bytes) { return nullptr; }
+            if(aligned > _end || static_cast<std::size_t>(_end - aligned) < bytes) { return nullptr; }
 
-            _active->cur = aligned + bytes;
+            _stats.on_allocate(bytes, static_cast<std::size_t>(aligned - _cur));
+            _cur = aligned + bytes;
             return aligned;
         }
+
+        /**
+         * @brief Lifts the active block's fill threshold, asking the block source to prepare the next block if
+         *        the active one is the last, and retries the allocation.
+         * @returns The allocation, or @c nullptr if there was no threshold to lift or the block is still too full.
+         */
+        void* try_alloc_past_threshold(std::size_t bytes, std::size_t alignment) noexcept {
+            if constexpr (prepares_blocks) {
+                if(_end != _active->end) {
+                    _end = _active->end;
+                    if(!_active->next) {
+                        const std::size_t next {_growth.next_capacity(_active->capacity, 0, _block_size)};
+                        _source.prepare(_source.round_size(next + header_bytes));
+                    }
+                    return try_alloc_at_active(bytes, alignment);
+                }
+            }
+            return nullptr;
+        }
     };
 
 
+    /**
+     * @brief The default arena, drawing blocks from the global heap.
+     */
+    using arena = basic_arena<>;
+
+    /**
+     * @brief Concept denoting any arena that can back a @c cma_resource or @c cma_allocator.
+     *
+     * @details
+     * The adaptors only need raw byte allocation; markers and factories are not required.
+     */
+    template<typename A>
+    concept bump_arena = requires(A& a, std::size_t n) {
+        { a.allocate_bytes(n, n) } -> std::same_as<void*>;
+    };
+
     /**
      * @brief Main adaptor for use with @c std::pmr structures.
      * This class implements the required functions as specified by cppref.
+     * @tparam Arena The arena type backing the resource (see @c cma_resource for the default arena).
      */
-    class cma_resource 
+    template<bump_arena Arena>
+    class basic_cma_resource 
         : public std::pmr::memory_resource {
     public:
             
@@ -433,14 +1382,14 @@ namespace cma {
          * @brief Primary constructor for the memory resource.
          * @param a The arena that the memory resource will use to manage memory.
          */
-        explicit cma_resource(arena& a) noexcept
+        explicit basic_cma_resource(Arena& a) noexcept
             : _a{&a} 
         {}
 
     private:
 
         /// @brief The memory arena to be leveraged by the memory resource.
-        arena* _a;
+        Arena* _a;
 
         /**
          * @brief Allocates raw storage for this @c memory_resource
@@ -459,13 +1408,25 @@ namespace cma {
         }
 
         /**
-         * @brief Deallocates raw storage for this @c memory_resource (not currently supported by model)
+         * @brief Deallocates raw storage for this @c memory_resource.
+         * 
+         * @details
+         * Arenas free in bulk, so only the most recent allocation can be reclaimed (when the arena supports
+         * @c try_shrink); any other deallocation is a no-op.
          * 
          * @param p The pointer to the block of raw storage to deallocate.
          * @param bytes The number of bytes to deallocate
          * @param alignment The alignment of the memory.
          */
-        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {}
+        void do_deallocate(void* p, std::size_t bytes, [[maybe_unused]] std::size_t alignment) override {
+            bool reclaimed {false};
+            if constexpr (requires { _a->try_shrink(p, bytes, 0); }) {
+                reclaimed = _a->try_shrink(p, bytes, 0);
+            }
+            if constexpr (requires { _a->stats().on_deallocate(bytes, reclaimed); }) {
+                _a->stats().on_deallocate(bytes, reclaimed);
+            }
+        }
 
         /**
          * @brief Compares for equality with @p other memory resource.
@@ -483,8 +1444,18 @@ namespace cma {
 
     };
 
-    template<typename T>
-    class cma_allocator {
+    /**
+     * @brief Memory resource over the default @c arena.
+     */
+    using cma_resource = basic_cma_resource<arena>;
+
+    /**
+     * @brief Allocator adaptor for standard containers.
+     * @tparam T The element type.
+     * @tparam Arena The arena type backing the allocator (see @c cma_allocator for the default arena).
+     */
+    template<typename T, bump_arena Arena>
+    class basic_cma_allocator {
     public:
         using value_type = T;
 
@@ -494,11 +1465,11 @@ namespace cma {
 
         using is_always_equal = std::false_type;
 
-        cma_allocator() noexcept = default;
-        explicit cma_allocator(arena& a) noexcept : _a{&a} {}
+        basic_cma_allocator() noexcept = default;
+        explicit basic_cma_allocator(Arena& a) noexcept : _a{&a} {}
 
         template<typename U>
-        cma_allocator(const cma_allocator<U>& other) noexcept : _a{other.arena_ptr()} {}
+        basic_cma_allocator(const basic_cma_allocator<U, Arena>& other) noexcept : _a{other.arena_ptr()} {}
 
         [[nodiscard]]
         T* allocate(std::size_t n) {
@@ -516,18 +1487,35 @@ namespace cma {
             return static_cast<T*>(p);
         }
 
-        void deallocate(T*, std::size_t) noexcept {} // no-op for now.
+        void deallocate(T* p, std::size_t n) noexcept {
+            // Only the most recent allocation can be reclaimed; anything else is released with the arena.
+            if(!p) { return; }
+
+            bool reclaimed {false};
+            if constexpr (requires { _a->try_shrink(p, n, 0); }) {
+                reclaimed = _a->try_shrink(p, n * sizeof(T), 0);
+            }
+            if constexpr (requires { _a->stats().on_deallocate(n, reclaimed); }) {
+                _a->stats().on_deallocate(n * sizeof(T), reclaimed);
+            }
+        }
 
         std::size_t max_size() const noexcept {
             return std::numeric_limits<std::size_t>::max() / sizeof(T);
         }
 
-        arena* arena_ptr() const noexcept { return _a; }
+        Arena* arena_ptr() const noexcept { return _a; }
 
     private:
 
-        arena* _a {nullptr};
+        Arena* _a {nullptr};
     };
+
+    /**
+     * @brief Allocator over the default @c arena.
+     */
+    template<typename T>
+    using cma_allocator = basic_cma_allocator<T, arena>;
 }
 
 #endif
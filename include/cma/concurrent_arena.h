@@ -0,0 +1,319 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_CONCURRENT_ARENA_H_INCLUDE
+#define CMA_CONCURRENT_ARENA_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <atomic>
+#include <mutex>
+
+/*
+ * An arena that may be shared between threads.
+ *
+ * The fast path is a compare-and-swap on the active block's cursor; no lock is taken while the active block has
+ * room. When it runs out, the first thread to take the growth mutex installs the next block and every other thread
+ * simply retries against it once the mutex is released (a single winner per block switch).
+ *
+ * Markers are not offered, since a rollback cannot be ordered against other threads' allocations; objects whose
+ * construction throws simply leave their bytes behind. @c reset() and @c release() require that no other thread is
+ * allocating.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Block header for a @c basic_concurrent_arena, stored at the start of the block's storage (or, for
+     *        over-aligned block sources, apart from it; see @c block).
+     */
+    struct concurrent_block {
+
+        /// @brief Next free byte within the block; [data, end].
+        std::atomic<std::byte*> cur {nullptr};
+
+        /// @brief Start of raw storage for this block (size = capacity)
+        std::byte* data {nullptr};
+
+        /// @brief One past the last byte of this block's storage.
+        std::byte* end  {nullptr};
+
+        /// @brief Next block in the linked-list.
+        concurrent_block* next {nullptr};
+
+        /// @brief Size of the block's usable storage in bytes (excluding the header).
+        std::size_t capacity {0};
+
+        static constexpr std::size_t header_size() noexcept {
+            return impl::round_up(sizeof(concurrent_block), alignof(std::max_align_t));
+        }
+
+        /**
+         * @param bytes The size of the block's storage in bytes, including @c header_size().
+         */
+        explicit concurrent_block(std::size_t bytes) noexcept
+            : cur{reinterpret_cast<std::byte*>(this) + header_size()}
+            , data{reinterpret_cast<std::byte*>(this) + header_size()}
+            , end{reinterpret_cast<std::byte*>(this) + bytes}
+            , capacity{bytes - header_size()}
+        {}
+
+        /**
+         * @param storage The start of the block's storage (and data), the header being allocated apart from it.
+         * @param capacity The size of the block's storage in bytes.
+         */
+        concurrent_block(std::byte* storage, std::size_t capacity) noexcept
+            : cur{storage}
+            , data{storage}
+            , end{storage + capacity}
+            , capacity{capacity}
+        {}
+
+        concurrent_block(const concurrent_block&) = delete;
+
+        concurrent_block& operator=(const concurrent_block&) = delete;
+
+        /**
+         * @brief Attempts to bump the cursor of this block.
+         * @returns The allocated storage, or @c nullptr if the block does not have room.
+         */
+        void* try_alloc(std::size_t bytes, std::size_t alignment) noexcept {
+            std::byte* old {cur.load(std::memory_order_relaxed)};
+            std::byte* aligned {nullptr};
+
+            do {
+                aligned = impl::align_up(old, alignment);
+                if(aligned > end || static_cast<std::size_t>(end - aligned) < bytes) { return nullptr; }
+            } while(!cur.compare_exchange_weak(old, aligned + bytes, std::memory_order_relaxed));
+
+            return aligned;
+        }
+    };
+
+    /**
+     * @brief Thread-safe arena with a lock-free bump fast path.
+     * @tparam GrowthPolicy The policy choosing the capacity of new blocks (default = @c geometric_growth<>).
+     * @tparam BlockSource The provider of raw storage for each block (default = @c heap_block_source).
+     */
+    template<growth_policy GrowthPolicy = geometric_growth<>, block_source BlockSource = heap_block_source>
+    class basic_concurrent_arena {
+    public:
+
+        /**
+         * @brief Explicit ctor for an arena with an initial size per block.
+         * @param initial_block_size The initial size of each memory block in the arena.
+         * @param source The block source to draw storage from.
+         * @param growth The growth policy instance (for stateful policies).
+         */
+        explicit basic_concurrent_arena(std::size_t initial_block_size = 64 * 1024, BlockSource source = {}, GrowthPolicy growth = {})
+            : _source{std::move(source)}
+            , _growth{std::move(growth)}
+            , _block_size{std::max<std::size_t>(initial_block_size, 1024)}
+            , _head{new_block(_block_size)}
+            , _active{_head}
+        {}
+
+        basic_concurrent_arena(const basic_concurrent_arena&) = delete;
+
+        basic_concurrent_arena& operator=(const basic_concurrent_arena&) = delete;
+
+        ~basic_concurrent_arena() {
+            for(concurrent_block* b {_head}; b;) {
+                concurrent_block* next {b->next};
+                delete_block(b);
+                b = next;
+            }
+        }
+
+        /**
+         * @brief Allocates bytes in the arena; safe to call from any number of threads.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The alignment of the allocation (default = max_align_t)
+         */
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if(bytes == 0) { return nullptr; }
+
+            if(alignment == 0 || !impl::is_pow_2(alignment)) {
+                alignment = alignof(std::max_align_t);
+            }
+
+            for(;;) {
+                concurrent_block* b {_active.load(std::memory_order_acquire)};
+                if(void* p {b->try_alloc(bytes, alignment)}) { return p; }
+
+                grow(b, bytes, alignment);
+            }
+        }
+
+        /**
+         * @brief Arena object factory
+         * @tparam T The type to construct in the arena
+         * @tparam Args The constructor arg types to forward
+         * @param args The arguments to forward for construction
+         * @returns The pointer to the object constructed in the arena.
+         * @note Should construction throw, the storage is not reclaimed.
+         */
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+            return ::new (allocate_bytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Rewinds every block while retaining all of them for reuse.
+         * @warning No other thread may be allocating from the arena.
+         */
+        void reset() noexcept {
+            for(concurrent_block* b {_head}; b; b = b->next) {
+                b->cur.store(b->data, std::memory_order_relaxed);
+            }
+
+            _active.store(_head, std::memory_order_release);
+        }
+
+        /**
+         * @brief Rewinds the arena and frees blocks beyond a retained byte budget (see @c basic_arena::release).
+         * @warning No other thread may be allocating from the arena.
+         */
+        void release(std::size_t retained_bytes = 0) noexcept {
+            std::size_t kept {0};
+            concurrent_block* tail {_head};
+
+            for(concurrent_block* b {_head->next}; b;) {
+                concurrent_block* next {b->next};
+
+                if(b->capacity <= retained_bytes - kept) {
+                    kept += b->capacity;
+                    tail->next = b;
+                    tail = b;
+                } else {
+                    delete_block(b);
+                }
+
+                b = next;
+            }
+
+            tail->next = nullptr;
+            reset();
+        }
+
+        /// @brief Alignment of every block's data (the block source's base alignment).
+        static constexpr std::size_t base_alignment {impl::block_alignment<BlockSource>()};
+
+        /// @brief Over-aligned sources keep their alignment (and page-multiple sizes) for the data by allocating
+        ///        block headers apart from the storage (see @c basic_arena::detached_header).
+        static constexpr bool detached_header {base_alignment > alignof(std::max_align_t)};
+
+        /// @brief Bytes of each block's storage taken by its header.
+        static constexpr std::size_t header_bytes {detached_header ? 0 : concurrent_block::header_size()};
+
+    private:
+
+        /// @brief The provider of block storage.
+        [[no_unique_address]] BlockSource _source;
+
+        /// @brief The policy sizing new blocks.
+        [[no_unique_address]] GrowthPolicy _growth;
+
+        /// @brief The size blocks stored in the arena.
+        std::size_t _block_size {0};
+
+        /// @brief The head block of the arena.
+        concurrent_block* _head {nullptr};
+
+        /// @brief The block allocations are currently bumped from.
+        alignas(64) std::atomic<concurrent_block*> _active {nullptr};
+
+        /// @brief Serializes block switches (the slow path).
+        std::mutex _grow_mutex;
+
+        /**
+         * @brief Switches the arena past the (full) block @p seen, unless another thread already has.
+         */
+        void grow(concurrent_block* seen, std::size_t bytes, std::size_t alignment) {
+            std::lock_guard lock{_grow_mutex};
+            if(_active.load(std::memory_order_relaxed) != seen) { return; }
+
+            // Block data is aligned to the base alignment, so only stronger alignments need slack for padding.
+            std::size_t need {bytes};
+            if(alignment > base_alignment && impl::overflow_addition(bytes, alignment - base_alignment, need)) {
+                throw std::bad_alloc{};
+            }
+
+            // Blocks past the active one are empty (see reset), so reuse the first that fits before growing.
+            for(concurrent_block* b {seen->next}; b; b = b->next) {
+                if(need <= b->capacity) {
+                    _active.store(b, std::memory_order_release);
+                    return;
+                }
+            }
+
+            auto* b {new_block(_growth.next_capacity(seen->capacity, need, _block_size))};
+            b->next = seen->next;
+            seen->next = b;
+            _active.store(b, std::memory_order_release);
+        }
+
+        /**
+         * @brief Creates a block, with its header at the start of storage drawn from the block source (or, for
+         *        over-aligned sources, on the heap; see @c detached_header).
+         * @param capacity The minimum usable capacity of the block (rounded up by the block source).
+         */
+        concurrent_block* new_block(std::size_t capacity) {
+            std::size_t bytes {0};
+            if(impl::overflow_addition(capacity, header_bytes, bytes)) { throw std::bad_alloc{}; }
+
+            bytes = _source.round_size(bytes);
+            if(bytes < header_bytes + capacity) { throw std::bad_alloc{}; }
+
+            auto* storage {static_cast<std::byte*>(_source.allocate(bytes))};
+
+            if constexpr (detached_header) {
+                try {
+                    return new concurrent_block(storage, bytes);
+                } catch (...) {
+                    _source.deallocate(storage, bytes);
+                    throw;
+                }
+            } else {
+                return ::new (storage) concurrent_block(bytes);
+            }
+        }
+
+        /**
+         * @brief Returns a block's storage (header included) to the block source.
+         */
+        void delete_block(concurrent_block* b) noexcept {
+            const std::size_t bytes {b->capacity + header_bytes};
+            void* storage {detached_header ? static_cast<void*>(b->data) : static_cast<void*>(b)};
+
+            if constexpr (detached_header) { delete b; } else { b->~concurrent_block(); }
+            _source.deallocate(storage, bytes);
+        }
+    };
+
+    /**
+     * @brief The default concurrent arena, drawing blocks from the global heap.
+     */
+    using concurrent_arena = basic_concurrent_arena<>;
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_DECOMMIT_H_INCLUDE
+#define CMA_DECOMMIT_H_INCLUDE
+
+#include <cma/cmalib.h>
+#include <cma/page_size.h>
+
+#include <array>
+
+#include <sys/mman.h>
+
+/*
+ * POSIX only (MADV_FREE where available).
+ *
+ * An arena cycled with reset() keeps every block it ever grew, so one spike leaves its doubled blocks, and their
+ * pages, resident for the arena's lifetime. release() frees whole blocks, but the next spike then pays for new
+ * blocks all over again. Trimming sits in between: blocks stay allocated, and only the pages under their data past
+ * a retained size are handed back with madvise.
+ *
+ * MADV_DONTNEED drops the pages at once (resident memory falls immediately; reuse refaults zeroed pages).
+ * MADV_FREE only marks them reclaimable: they stay resident, and reuse is free, until the system is short of
+ * memory. How much to retain comes from a hysteresis over the last few cycles' high-water marks, so a steady
+ * workload never gives up pages it will need again.
+ */
+
+namespace cma {
+
+    /**
+     * @brief How decommitted pages are given back.
+     */
+    enum class page_advice {
+        dont_need,  ///< MADV_DONTNEED: released immediately.
+        free,       ///< MADV_FREE: released lazily, under memory pressure (MADV_DONTNEED where unsupported).
+    };
+
+    namespace impl {
+
+        /**
+         * @brief Returns the whole pages within [p, p + bytes) to the system.
+         */
+        inline void decommit(void* p, std::size_t bytes, page_advice advice) noexcept {
+            const std::size_t page {page_size()};
+            auto* first {static_cast<std::byte*>(p)};
+
+            // Partial pages at either end are shared with live data (or a block header).
+            std::byte* lo {align_up(first, page)};
+            std::byte* hi {first + bytes};
+            if(lo >= hi) { return; }
+
+            const std::size_t len {static_cast<std::size_t>(hi - lo) & ~(page - 1)};
+            if(len == 0) { return; }
+
+#if defined(MADV_FREE)
+            if(advice == page_advice::free && ::madvise(lo, len, MADV_FREE) == 0) { return; }
+#endif
+            ::madvise(lo, len, MADV_DONTNEED);
+        }
+
+    } // namespace impl
+
+    /**
+     * @brief Block source able to return the pages of empty blocks to the system (enables @c basic_arena::trim).
+     * @tparam Upstream The block source storage is drawn from (anonymous memory: heap or private mappings).
+     * @tparam Advice How decommitted pages are given back.
+     */
+    template<block_source Upstream = heap_block_source, page_advice Advice = page_advice::dont_need>
+    struct decommit_block_source {
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        [[no_unique_address]] Upstream upstream {};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return upstream.round_size(bytes); }
+
+        void* allocate(std::size_t bytes) { return upstream.allocate(bytes); }
+
+        void deallocate(void* p, std::size_t bytes) noexcept { upstream.deallocate(p, bytes); }
+
+        void decommit(void* p, std::size_t bytes) noexcept { impl::decommit(p, bytes, Advice); }
+    };
+
+    /**
+     * @brief Chooses how much of an arena to retain when trimming, from its last few high-water marks.
+     * @tparam History The number of cycles remembered.
+     */
+    template<std::size_t History = 8>
+    class trim_hysteresis {
+    public:
+
+        static_assert(History > 0, "At least one cycle must be remembered!");
+
+        /**
+         * @param retained_floor The bytes always retained, whatever the recent cycles used.
+         */
+        explicit trim_hysteresis(std::size_t retained_floor = 0) noexcept
+            : _floor{retained_floor}
+        {}
+
+        /**
+         * @brief Records a cycle's high-water mark, and returns the bytes to retain: the largest mark among the
+         *        last @c History cycles (or the floor, if larger).
+         */
+        std::size_t record(std::size_t high_water) noexcept {
+            _marks[_next] = high_water;
+            _next = (_next + 1) % History;
+            return retained_bytes();
+        }
+
+        std::size_t retained_bytes() const noexcept {
+            return std::max(_floor, *std::ranges::max_element(_marks));
+        }
+
+        /**
+         * @brief Ends a cycle of @p a: records how far it reached (rolled back or freed allocations included, see
+         *        @c basic_arena::peak_extent_bytes) and trims it to the retained size.
+         */
+        template<typename Arena>
+        void reset(Arena& a) noexcept {
+            a.trim(record(a.peak_extent_bytes()));
+        }
+
+    private:
+
+        std::size_t _floor;
+
+        std::array<std::size_t, History> _marks {};
+
+        std::size_t _next {0};
+    };
+
+    /**
+     * @brief Arena whose pages can be trimmed on reset (see @c trim_hysteresis).
+     */
+    using trimming_arena = basic_arena<geometric_growth<>, decommit_block_source<>>;
+
+} // namespace cma
+
+#endif
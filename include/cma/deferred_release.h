@@ -0,0 +1,270 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_DEFERRED_RELEASE_H_INCLUDE
+#define CMA_DEFERRED_RELEASE_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/*
+ * Destroying (or releasing) an arena returns each of its blocks to the block source on the calling thread; for an
+ * arena holding gigabytes, the frees and unmaps add up to a stall of milliseconds. With the deferred block source,
+ * the arena hands its whole block chain over in one call instead, and a reclaimer thread frees it later.
+ *
+ * The hand-over is O(1): the chain is queued through a node placed in its own first block (whose data is no longer
+ * in use), with a single compare-and-swap. Memory awaiting release is bounded: a chain that would take the pending
+ * bytes past the reclaimer's limit is freed on the calling thread, as without deferral.
+ *
+ * Freed blocks outlive the arena (and its source), so the upstream source must be stateless. Deferring to a
+ * @c cached_block_source makes the reclaimer return blocks to the block cache instead of the system.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Snapshot of a block reclaimer's counters.
+     */
+    struct reclaimer_stats {
+
+        /// @brief Chains handed to the reclaimer thread.
+        std::size_t deferred {0};
+
+        /// @brief Chains freed by the caller, because the pending bytes would have exceeded the limit.
+        std::size_t synchronous {0};
+
+        /// @brief Storage bytes queued and not yet freed.
+        std::size_t pending_bytes {0};
+    };
+
+    /**
+     * @brief Background thread freeing block chains handed over by arenas.
+     */
+    class block_reclaimer {
+    public:
+
+        /// @brief Function freeing every block of a chain.
+        using free_fn = void (*)(const block_chain&) noexcept;
+
+        /**
+         * @brief The process-wide reclaimer (1 GiB pending limit).
+         * @note Intentionally never destroyed, so arenas with static storage may still hand over blocks at exit.
+         */
+        static block_reclaimer& instance() noexcept {
+            static block_reclaimer* reclaimer {new block_reclaimer{}};
+            return *reclaimer;
+        }
+
+        /**
+         * @param limit The most storage bytes that may be awaiting release at once.
+         */
+        explicit block_reclaimer(std::size_t limit = std::size_t{1} << 30) noexcept
+            : _limit{limit}
+        {}
+
+        block_reclaimer(const block_reclaimer&) = delete;
+
+        block_reclaimer& operator=(const block_reclaimer&) = delete;
+
+        /**
+         * @brief Frees every pending chain and stops the thread.
+         */
+        ~block_reclaimer() {
+            if(_thread.joinable()) {
+                _stop.store(true, std::memory_order_release);
+                wake();
+                _thread.join();
+            }
+        }
+
+        /**
+         * @brief Queues @p chain to be freed by @p free on the reclaimer thread, or frees it right away if that
+         *        would exceed the limit (or the thread cannot be started).
+         */
+        void submit(const block_chain& chain, free_fn free) noexcept {
+            if(!chain.head) { return; }
+
+            if(chain.head->capacity < sizeof(job) || !started() || !reserve(chain.bytes)) {
+                _synchronous.fetch_add(1, std::memory_order_relaxed);
+                free(chain);
+                return;
+            }
+
+            // The first block's data is dead, and carries the queue node until the chain is freed.
+            job* j {::new (static_cast<void*>(chain.head->data)) job{nullptr, chain, free}};
+
+            j->next = _jobs.load(std::memory_order_relaxed);
+            while(!_jobs.compare_exchange_weak(j->next, j, std::memory_order_release, std::memory_order_relaxed)) {}
+            wake();
+
+            _deferred.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Blocks until every chain queued so far has been freed.
+         */
+        void drain() const noexcept {
+            for(std::size_t pending {_pending.load(std::memory_order_acquire)}; pending != 0;
+                pending = _pending.load(std::memory_order_acquire)) {
+                _pending.wait(pending, std::memory_order_acquire);
+            }
+        }
+
+        reclaimer_stats stats() const noexcept {
+            return reclaimer_stats{
+                _deferred.load(std::memory_order_relaxed),
+                _synchronous.load(std::memory_order_relaxed),
+                _pending.load(std::memory_order_relaxed),
+            };
+        }
+
+    private:
+
+        /// @brief Queue node, stored in the first block of the chain it carries.
+        struct job {
+            job* next;
+            block_chain chain;
+            free_fn free;
+        };
+
+        std::size_t _limit;
+
+        /// @brief Lock-free stack of queued chains (the thread takes all of them at once).
+        std::atomic<job*> _jobs {nullptr};
+
+        std::atomic<std::size_t> _pending {0};
+
+        std::atomic<std::size_t> _deferred {0};
+        std::atomic<std::size_t> _synchronous {0};
+
+        /// @brief Bumped (and notified) whenever the thread has something to do.
+        std::atomic<std::uint32_t> _wakeups {0};
+
+        std::atomic<bool> _stop {false};
+
+        /// @brief Guards the (lazy) start of the thread.
+        std::mutex _start;
+
+        std::atomic<bool> _running {false};
+
+        std::thread _thread;
+
+        /**
+         * @brief Adds @p bytes to the pending bytes, unless that would exceed the limit.
+         */
+        bool reserve(std::size_t bytes) noexcept {
+            std::size_t pending {_pending.load(std::memory_order_relaxed)};
+            do {
+                if(bytes > _limit || pending > _limit - bytes) { return false; }
+            } while(!_pending.compare_exchange_weak(pending, pending + bytes, std::memory_order_relaxed));
+            return true;
+        }
+
+        /**
+         * @brief Starts the thread on first use.
+         */
+        bool started() noexcept {
+            if(_running.load(std::memory_order_acquire)) { return true; }
+
+            std::lock_guard lock{_start};
+            if(!_thread.joinable()) {
+                try {
+                    _thread = std::thread{[this] { run(); }};
+                } catch (...) {
+                    return false;
+                }
+            }
+
+            _running.store(true, std::memory_order_release);
+            return true;
+        }
+
+        void wake() noexcept {
+            _wakeups.fetch_add(1, std::memory_order_release);
+            _wakeups.notify_one();
+        }
+
+        void run() noexcept {
+            for(;;) {
+                // Read before checking for work, so a chain queued in between still ends the wait.
+                const std::uint32_t seen {_wakeups.load(std::memory_order_acquire)};
+
+                job* j {_jobs.exchange(nullptr, std::memory_order_acquire)};
+                if(!j) {
+                    if(_stop.load(std::memory_order_acquire)) { return; }
+                    _wakeups.wait(seen, std::memory_order_acquire);
+                    continue;
+                }
+
+                while(j) {
+                    // The node lives in the chain, so everything needed is copied out before freeing it.
+                    const job current {*j};
+                    current.free(current.chain);
+
+                    _pending.fetch_sub(current.chain.bytes, std::memory_order_release);
+                    _pending.notify_all();
+                    j = current.next;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Block source whose freed blocks are released by a @c block_reclaimer, off the arena's thread.
+     * @tparam Upstream The (stateless) block source storage is drawn from and returned to.
+     */
+    template<block_source Upstream = heap_block_source>
+    struct deferred_block_source {
+
+        static_assert(std::is_empty_v<Upstream>, "Blocks are freed after the arena is gone; the upstream source must be stateless!");
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        /// @brief The reclaimer freed blocks are handed to.
+        block_reclaimer* reclaimer {&block_reclaimer::instance()};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return Upstream{}.round_size(bytes); }
+
+        void* allocate(std::size_t bytes) { return Upstream{}.allocate(bytes); }
+
+        void deallocate(void* p, std::size_t bytes) noexcept { Upstream{}.deallocate(p, bytes); }
+
+        void deallocate_chain(const block_chain& chain) noexcept { reclaimer->submit(chain, &free_chain); }
+
+    private:
+
+        static void free_chain(const block_chain& chain) noexcept {
+            chain.for_each_storage([](void* p, std::size_t bytes) { Upstream{}.deallocate(p, bytes); });
+        }
+    };
+
+    /**
+     * @brief Arena whose blocks are freed in the background when it is destroyed or released.
+     */
+    using deferred_arena = basic_arena<geometric_growth<>, deferred_block_source<>>;
+
+} // namespace cma
+
+#endif
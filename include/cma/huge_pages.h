@@ -0,0 +1,108 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_HUGE_PAGES_H_INCLUDE
+#define CMA_HUGE_PAGES_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <sys/mman.h>
+
+/*
+ * POSIX only, with Linux specific fast paths.
+ *
+ * Blocks are mapped at huge page granularity and alignment so that the kernel can back them with huge pages,
+ * reducing the number of TLB entries needed to cover large arenas. Explicit huge pages (MAP_HUGETLB) are tried
+ * first; these require a reserved pool (vm.nr_hugepages) and so commonly fail, in which case an aligned regular
+ * mapping is created and the kernel is asked to back it with transparent huge pages (MADV_HUGEPAGE).
+ */
+
+namespace cma {
+
+    /**
+     * @brief Supported huge page sizes.
+     */
+    enum class huge_page_size : std::size_t {
+        size_2mib = std::size_t{2} << 20,
+        size_1gib = std::size_t{1} << 30,
+    };
+
+    /**
+     * @brief Block source mapping huge page sized and aligned blocks.
+     * @tparam PageSize The huge page size blocks are rounded and aligned to.
+     */
+    template<huge_page_size PageSize = huge_page_size::size_2mib>
+    struct huge_page_block_source {
+
+        /// @brief Size (and alignment) of the huge pages backing each block.
+        static constexpr std::size_t page_bytes {static_cast<std::size_t>(PageSize)};
+
+        /// @brief Base alignment of every block's storage.
+        static constexpr std::size_t alignment {page_bytes};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return impl::round_up(bytes, page_bytes); }
+
+        /**
+         * @brief Maps a block of @p bytes, aligned to @c page_bytes.
+         * @param bytes The size of the block (a multiple of @c page_bytes).
+         * @throws std::bad_alloc if no mapping could be created.
+         */
+        void* allocate(std::size_t bytes) {
+            if(bytes == 0) { throw std::bad_alloc{}; }
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+            constexpr int huge_flags {MAP_HUGETLB | (std::countr_zero(page_bytes) << MAP_HUGE_SHIFT)};
+            void* p {::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | huge_flags, -1, 0)};
+            if(p != MAP_FAILED) { return p; }
+#endif
+
+            // Over-map by one page, then trim the misaligned head and tail.
+            std::size_t span {0};
+            if(impl::overflow_addition(bytes, page_bytes, span)) { throw std::bad_alloc{}; }
+
+            void* raw {::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+            if(raw == MAP_FAILED) { throw std::bad_alloc{}; }
+
+            auto* first {static_cast<std::byte*>(raw)};
+            std::byte* aligned {impl::align_up(first, page_bytes)};
+            const auto head {static_cast<std::size_t>(aligned - first)};
+
+            if(head != 0) { ::munmap(first, head); }
+            if(span - head != bytes) { ::munmap(aligned + bytes, span - head - bytes); }
+
+#if defined(MADV_HUGEPAGE)
+            ::madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+            return aligned;
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            ::munmap(p, bytes);
+        }
+    };
+
+    /**
+     * @brief Arena whose blocks are backed by (2 MiB) huge pages.
+     */
+    using huge_page_arena = basic_arena<geometric_growth<>, huge_page_block_source<>>;
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,418 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_MMAP_ARENA_H_INCLUDE
+#define CMA_MMAP_ARENA_H_INCLUDE
+
+#include <cma/cmalib.h>
+#include <cma/page_size.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * POSIX only.
+ *
+ * A file-backed arena: one process builds a structure into it, syncs, and later processes map the file (read-only)
+ * and use the structure as is, without rebuilding or deserializing it.
+ *
+ * The file starts with a header page (magic, version, the address it was built at, the cursor, the offset of a root
+ * object, and a table of the blocks the file grew by), followed by the data. Like @c virtual_arena, the arena
+ * reserves its whole address range up front and maps the file over it as it grows, so the data is contiguous and
+ * never moves while building.
+ *
+ * When a later process can map the file at the address it was built at, pointers stored in the data stay valid.
+ * Otherwise the mapping is relocated (@c relocated()) and only offsets (@c offset_of, @c at) may be followed.
+ * Objects are never destroyed by the arena; what is stored should not own anything outside of it.
+ */
+
+namespace cma {
+
+    /**
+     * @brief How an @c mmap_arena opens its file.
+     */
+    enum class mmap_mode {
+        create,     ///< Create (or truncate) the file and build into it.
+        open,       ///< Reopen an existing file to keep building into it.
+        read_only,  ///< Map an existing file read-only.
+    };
+
+    /**
+     * @brief One contiguous extent the file grew by, recorded in the header's block table.
+     */
+    struct mmap_extent {
+
+        /// @brief File offset of the extent (equal to its offset from the mapping base).
+        std::uint64_t offset {0};
+
+        /// @brief Size of the extent in bytes.
+        std::uint64_t size {0};
+    };
+
+    /**
+     * @brief Header at the start of an @c mmap_arena file.
+     */
+    struct mmap_header {
+
+        static constexpr std::uint64_t magic_value {0x50414d4d414d43ull};  // "CMAMMAP"
+
+        static constexpr std::uint32_t current_version {1};
+
+        std::uint64_t magic {magic_value};
+
+        std::uint32_t version {current_version};
+
+        /// @brief Number of used entries in @c blocks.
+        std::uint32_t block_count {0};
+
+        /// @brief Address the file was built at; stored pointers are only valid when mapped there.
+        std::uint64_t base_address {0};
+
+        /// @brief Size of the address range reserved for the file (its maximum size).
+        std::uint64_t reserved {0};
+
+        /// @brief Offset of the first data byte (the header, rounded to pages).
+        std::uint64_t data_offset {0};
+
+        /// @brief Offset of the next free byte.
+        std::uint64_t used {0};
+
+        /// @brief Offset of the root object (0 = none).
+        std::uint64_t root {0};
+
+        /// @brief The block table, filling the rest of the header page.
+        mmap_extent blocks[(4096 - 56) / sizeof(mmap_extent)] {};
+    };
+
+    static_assert(sizeof(mmap_header) <= 4096, "The header must fit a page!");
+
+    /**
+     * @brief Arena persisted in a memory-mapped file.
+     */
+    class mmap_arena {
+    public:
+
+        /**
+         * @brief Marker used to roll-back some of the memory in the arena.
+         */
+        struct marker {
+            std::byte* cur {nullptr};
+        };
+
+        /**
+         * @brief Opens (or creates) the arena's file and maps it.
+         * @param path The file backing the arena.
+         * @param mode How to open the file (default = create).
+         * @param reserve_bytes The largest size the file may grow to when creating (default = 64 GiB).
+         * @param base_hint The address to build at when creating, e.g. a fixed address agreed on by every process
+         *                  mapping the file (default = anywhere).
+         * @throws std::system_error if the file cannot be opened or mapped; std::runtime_error if it is not an
+         *         arena file of this version.
+         */
+        explicit mmap_arena(const char* path, mmap_mode mode = mmap_mode::create,
+                            std::size_t reserve_bytes = std::size_t{64} << 30, void* base_hint = nullptr)
+            : _read_only{mode == mmap_mode::read_only}
+        {
+            const int flags {mode == mmap_mode::create ? O_RDWR | O_CREAT | O_TRUNC : _read_only ? O_RDONLY : O_RDWR};
+            _fd = ::open(path, flags | O_CLOEXEC, 0644);
+            if(_fd < 0) { throw_errno("open"); }
+
+            try {
+                if(mode == mmap_mode::create) {
+                    create(reserve_bytes, base_hint);
+                } else {
+                    map_existing();
+                }
+            } catch (...) {
+                unmap();
+                ::close(_fd);
+                throw;
+            }
+        }
+
+        mmap_arena(const mmap_arena&) = delete;
+
+        mmap_arena& operator=(const mmap_arena&) = delete;
+
+        /**
+         * @brief Records the cursor and unmaps the file (without forcing it to disk; see @c sync()).
+         */
+        ~mmap_arena() {
+            if(!_read_only) { header().used = used_offset(); }
+            unmap();
+            ::close(_fd);
+        }
+
+        /**
+         * @brief Main function to allocate bytes in the arena, growing the file as needed.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The alignment of the allocation (default = max_align_t)
+         * @throws std::bad_alloc if the arena is read-only, its reservation is exhausted, or the file cannot grow.
+         */
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if(bytes == 0) { return nullptr; }
+
+            if(alignment == 0 || !impl::is_pow_2(alignment)) {
+                alignment = alignof(std::max_align_t);
+            }
+
+            std::byte* aligned {impl::align_up(_cur, alignment)};
+
+            if(aligned > _limit || static_cast<std::size_t>(_limit - aligned) < bytes) {
+                if(_read_only || aligned > _end || static_cast<std::size_t>(_end - aligned) < bytes) { throw std::bad_alloc{}; }
+                grow(aligned + bytes);
+            }
+
+            _cur = aligned + bytes;
+            return aligned;
+        }
+
+        /**
+         * @brief Arena object factory
+         * @tparam T The type to construct in the arena
+         * @tparam Args The constructor arg types to forward
+         * @param args The arguments to forward for construction
+         * @returns The pointer to the object constructed in the arena.
+         * @note Objects are never destroyed; they outlive the process that made them.
+         */
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+
+            const marker m {create_marker()};
+            void* memory {allocate_bytes(sizeof(T), alignof(T))};
+
+            try {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            } catch (...) {
+                rollback_to(m);
+                throw;
+            }
+        }
+
+        marker create_marker() const noexcept {
+            return marker{_cur};
+        }
+
+        void rollback_to(const marker& m) noexcept {
+            if(!m.cur) { return; }
+            _cur = m.cur;
+        }
+
+        /**
+         * @brief Records @p object as the structure's entry point, found again through @c root().
+         */
+        template<typename T>
+        void set_root(const T* object) noexcept {
+            header().root = object ? offset_of(object) : 0;
+        }
+
+        /**
+         * @brief The root object recorded by @c set_root (at its offset, so valid even when relocated).
+         * @returns The root, or @c nullptr if none was set.
+         */
+        template<typename T>
+        T* root() const noexcept {
+            const std::uint64_t off {header().root};
+            return off ? at<T>(off) : nullptr;
+        }
+
+        /**
+         * @brief Offset of @p p from the base of the mapping; stable across processes.
+         */
+        std::uint64_t offset_of(const void* p) const noexcept {
+            return static_cast<std::uint64_t>(static_cast<const std::byte*>(p) - _base);
+        }
+
+        /**
+         * @brief The object at @p offset from the base of the mapping.
+         */
+        template<typename T>
+        T* at(std::uint64_t offset) const noexcept {
+            return reinterpret_cast<T*>(_base + offset);
+        }
+
+        /**
+         * @brief Records the cursor in the header and flushes the mapping to the file.
+         * @throws std::system_error if msync fails.
+         */
+        void sync() {
+            if(_read_only) { return; }
+
+            header().used = used_offset();
+            if(::msync(_base, mapped_bytes(), MS_SYNC) != 0) { throw_errno("msync"); }
+        }
+
+        /// @brief Start of the mapping (the header).
+        std::byte* base() const noexcept { return _base; }
+
+        /// @brief Whether the file is mapped at another address than it was built at (stored pointers are invalid).
+        bool relocated() const noexcept { return header().base_address != reinterpret_cast<std::uintptr_t>(_base); }
+
+        bool read_only() const noexcept { return _read_only; }
+
+        /// @brief Number of data bytes handed out (including alignment padding).
+        std::size_t used_bytes() const noexcept { return static_cast<std::size_t>(_cur - _base) - header().data_offset; }
+
+        /// @brief Size of the file (and of its mapping).
+        std::size_t mapped_bytes() const noexcept { return static_cast<std::size_t>(_mapped - _base); }
+
+        /// @brief The extents the file grew by.
+        std::span<const mmap_extent> blocks() const noexcept { return {header().blocks, header().block_count}; }
+
+    private:
+
+        /// @brief Number of bytes the file grows by at first; later extents double.
+        static constexpr std::size_t initial_extent {std::size_t{1} << 20};
+
+        static constexpr std::size_t max_blocks {std::extent_v<decltype(mmap_header::blocks)>};
+
+        int _fd {-1};
+
+        bool _read_only {false};
+
+        /// @brief Start of the mapping (and of the reserved range).
+        std::byte* _base    {nullptr};
+
+        /// @brief Next free byte; [data, mapped].
+        std::byte* _cur     {nullptr};
+
+        /// @brief One past the last byte of the file's mapping.
+        std::byte* _mapped  {nullptr};
+
+        /// @brief One past the last byte allocations may use (the cursor itself when read-only).
+        std::byte* _limit   {nullptr};
+
+        /// @brief One past the last reserved byte.
+        std::byte* _end     {nullptr};
+
+        [[noreturn]] static void throw_errno(const char* what) {
+            throw std::system_error{errno, std::generic_category(), what};
+        }
+
+        mmap_header& header() const noexcept { return *reinterpret_cast<mmap_header*>(_base); }
+
+        std::uint64_t used_offset() const noexcept { return static_cast<std::uint64_t>(_cur - _base); }
+
+        void unmap() noexcept {
+            if(_base) { ::munmap(_base, static_cast<std::size_t>(_end - _base)); }
+            _base = nullptr;
+        }
+
+        /**
+         * @brief Reserves the address range (at @p at, if given, without replacing existing mappings).
+         */
+        void reserve(std::size_t bytes, void* at) {
+            int flags {MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE};
+#if defined(MAP_FIXED_NOREPLACE)
+            if(at) { flags |= MAP_FIXED_NOREPLACE; }
+#endif
+            void* p {::mmap(at, bytes, PROT_NONE, flags, -1, 0)};
+            if(p == MAP_FAILED && at) {
+                p = ::mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            }
+            if(p == MAP_FAILED) { throw std::bad_alloc{}; }
+
+            _base = static_cast<std::byte*>(p);
+            _end = _base + bytes;
+        }
+
+        /**
+         * @brief Maps file bytes [from, to) over the reservation.
+         */
+        void map_file(std::size_t from, std::size_t to) {
+            const int prot {_read_only ? PROT_READ : PROT_READ | PROT_WRITE};
+            void* p {::mmap(_base + from, to - from, prot, MAP_SHARED | MAP_FIXED, _fd, static_cast<off_t>(from))};
+            if(p == MAP_FAILED) { throw_errno("mmap"); }
+
+            _mapped = _base + to;
+            _limit = _mapped;
+        }
+
+        void create(std::size_t reserve_bytes, void* base_hint) {
+            const std::size_t page {impl::page_size()};
+            const std::size_t data_offset {impl::round_up(sizeof(mmap_header), page)};
+            const std::size_t bytes {impl::round_up(std::max(reserve_bytes, data_offset + initial_extent), page)};
+
+            reserve(bytes, base_hint);
+            if(::ftruncate(_fd, static_cast<off_t>(data_offset)) != 0) { throw_errno("ftruncate"); }
+            map_file(0, data_offset);
+
+            mmap_header& h {*::new (_base) mmap_header{}};
+            h.base_address = reinterpret_cast<std::uintptr_t>(_base);
+            h.reserved = bytes;
+            h.data_offset = data_offset;
+            h.used = data_offset;
+
+            _cur = _base + data_offset;
+        }
+
+        void map_existing() {
+            mmap_header h {};
+            if(::pread(_fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))) { throw std::runtime_error{"cma::mmap_arena: truncated header"}; }
+            if(h.magic != mmap_header::magic_value) { throw std::runtime_error{"cma::mmap_arena: not an arena file"}; }
+            if(h.version != mmap_header::current_version) { throw std::runtime_error{"cma::mmap_arena: unsupported version"}; }
+
+            struct stat st {};
+            if(::fstat(_fd, &st) != 0) { throw_errno("fstat"); }
+            const auto size {static_cast<std::size_t>(st.st_size)};
+            if(h.used > size || h.data_offset > h.used || size > h.reserved) { throw std::runtime_error{"cma::mmap_arena: corrupt header"}; }
+
+            // A read-only mapping never grows; a reopened one may keep growing up to the original reservation.
+            reserve(_read_only ? size : h.reserved, reinterpret_cast<void*>(h.base_address));
+            map_file(0, size);
+
+            _cur = _base + h.used;
+            if(_read_only) { _limit = _cur; }
+        }
+
+        /**
+         * @brief Extends the file (by at least double the previous extent) such that [base, upto) is mapped.
+         * @throws std::bad_alloc if the file cannot be extended or the block table is full.
+         */
+        void grow(std::byte* upto) {
+            mmap_header& h {header()};
+            if(h.block_count == max_blocks) { throw std::bad_alloc{}; }
+
+            const std::size_t from {mapped_bytes()};
+            const std::size_t last {h.block_count ? static_cast<std::size_t>(h.blocks[h.block_count - 1].size) : initial_extent / 2};
+            const std::size_t want {std::max(static_cast<std::size_t>(upto - _base), from + last * 2)};
+            const std::size_t to {std::min(impl::round_up(want, impl::page_size()), static_cast<std::size_t>(_end - _base))};
+
+            if(::ftruncate(_fd, static_cast<off_t>(to)) != 0) { throw std::bad_alloc{}; }
+
+            try {
+                map_file(from, to);
+            } catch (const std::system_error&) {
+                throw std::bad_alloc{};
+            }
+
+            h.blocks[h.block_count++] = mmap_extent{from, to - from};
+        }
+    };
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_NUMA_H_INCLUDE
+#define CMA_NUMA_H_INCLUDE
+
+#include <cma/cmalib.h>
+#include <cma/page_size.h>
+
+#include <cstdio>
+#include <iterator>
+
+#include <sys/mman.h>
+
+#if defined(__linux__) && __has_include(<linux/mempolicy.h>)
+#   include <linux/mempolicy.h>
+#   include <sys/syscall.h>
+#   define CMA_HAS_NUMA 1
+#else
+#   define CMA_HAS_NUMA 0
+#endif
+
+/*
+ * Linux (other systems, and single-node machines, allocate normally).
+ *
+ * Memory is placed on a NUMA node when a page is first touched, by the node of the touching thread unless a memory
+ * policy says otherwise. An arena filled by one thread and read by threads on another node pays remote-memory
+ * latency on every access. The NUMA block source maps each block and binds it (mbind, issued as a raw syscall so
+ * libnuma is not required) to a chosen node, or to the node of the thread growing the arena, before any page is
+ * touched.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Number of NUMA nodes in the system (1 when unknown or unsupported).
+     */
+    inline int numa_node_count() noexcept {
+        static const int count {[] {
+            int highest {0};
+#if CMA_HAS_NUMA
+            // A list of ranges, e.g. "0" or "0-1,3"; only the highest node matters.
+            if(std::FILE* f {std::fopen("/sys/devices/system/node/possible", "r")}) {
+                int n {0};
+                while(std::fscanf(f, "%d", &n) == 1) {
+                    highest = std::max(highest, n);
+                    if(std::fgetc(f) == EOF) { break; }
+                }
+                std::fclose(f);
+            }
+#endif
+            return highest + 1;
+        }()};
+        return count;
+    }
+
+    /**
+     * @brief The node of the CPU the calling thread is running on (a hint; the thread may migrate), or 0.
+     */
+    inline int numa_current_node() noexcept {
+#if CMA_HAS_NUMA
+        unsigned cpu {0};
+        unsigned node {0};
+        if(::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) { return static_cast<int>(node); }
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief The node the page holding @p p lives on, or -1 if it is not yet backed (or cannot be queried).
+     */
+    inline int numa_node_of(const void* p) noexcept {
+#if CMA_HAS_NUMA
+        int node {-1};
+        if(::syscall(SYS_get_mempolicy, &node, nullptr, 0UL, p, MPOL_F_NODE | MPOL_F_ADDR) == 0) { return node; }
+        return -1;
+#else
+        return p ? 0 : -1;
+#endif
+    }
+
+    /**
+     * @brief Block source mapping blocks bound to a NUMA node.
+     */
+    struct numa_block_source {
+
+        /// @brief Node value meaning "the node of the thread allocating the block".
+        static constexpr int local_node {-1};
+
+        /// @brief Base alignment of every block's storage (mappings are page aligned).
+        static constexpr std::size_t alignment {4096};
+
+        /// @brief The node blocks are placed on, or @c local_node.
+        int node {local_node};
+
+        /// @brief Whether placement is mandatory (MPOL_BIND; a block that cannot be bound to the node is refused) or
+        ///        preferred (MPOL_PREFERRED; such a block falls back to the default first-touch policy).
+        bool strict {false};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return impl::round_up(bytes, impl::page_size()); }
+
+        /**
+         * @brief Maps a block of @p bytes and binds it to the source's node.
+         * @throws std::bad_alloc if no mapping could be created, or if the source is strict and the block could
+         *         not be bound (no such node, no permission, node offline).
+         */
+        void* allocate(std::size_t bytes) {
+            void* p {::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+            if(p == MAP_FAILED) { throw std::bad_alloc{}; }
+
+            if(!bind(p, bytes) && strict) {
+                ::munmap(p, bytes);
+                throw std::bad_alloc{};
+            }
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            ::munmap(p, bytes);
+        }
+
+    private:
+
+        /**
+         * @brief Binds the (untouched) mapping [p, p + bytes) to the source's node.
+         * @returns Whether the block is placed on that node: bound to it, or the system's only node.
+         */
+        bool bind(void* p, std::size_t bytes) const noexcept {
+            const int target {node == local_node ? numa_current_node() : node};
+            if(numa_node_count() == 1) { return target == 0; }
+
+#if CMA_HAS_NUMA
+            constexpr std::size_t mask_bits {sizeof(unsigned long) * 8};
+            unsigned long mask[4] {};
+
+            if(target >= 0 && static_cast<std::size_t>(target) < std::size(mask) * mask_bits) {
+                mask[target / mask_bits] = 1UL << (target % mask_bits);
+                return ::syscall(SYS_mbind, p, bytes, strict ? MPOL_BIND : MPOL_PREFERRED, mask,
+                                 std::size(mask) * mask_bits, 0U) == 0;
+            }
+#endif
+            return false;
+        }
+    };
+
+    /**
+     * @brief Arena whose blocks are placed on the node of the thread growing it.
+     */
+    using numa_arena = basic_arena<geometric_growth<>, numa_block_source>;
+
+} // namespace cma
+
+#undef CMA_HAS_NUMA
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_OFFSET_PTR_H_INCLUDE
+#define CMA_OFFSET_PTR_H_INCLUDE
+
+#include <cma/cmalib.h>
+
+#include <compare>
+#include <iterator>
+
+/*
+ * Raw pointers tie a structure to the address it was built at. An offset_ptr instead stores the distance from
+ * itself to its target, so a structure whose pointers all stay inside one region (an arena block, a mapped file,
+ * a shared memory segment) can be copied or mapped anywhere and remain valid.
+ *
+ * The price is an add on every dereference and a subtract on every store, and copying an offset_ptr on its own
+ * (out of the region) re-bases it, as it must. The offset 1 represents null, so an offset_ptr cannot point at the
+ * byte right after itself.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Self-relative pointer with full (random access, contiguous) pointer semantics.
+     * @tparam T The pointee type (may be void or const qualified).
+     */
+    template<typename T>
+    class offset_ptr {
+    public:
+        using element_type      = T;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T*;
+        using reference         = std::add_lvalue_reference_t<T>;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::contiguous_iterator_tag;
+
+        offset_ptr() noexcept = default;
+
+        offset_ptr(std::nullptr_t) noexcept {}
+
+        offset_ptr(T* p) noexcept { set(p); }
+
+        offset_ptr(const offset_ptr& other) noexcept { set(other.get()); }
+
+        template<typename U> requires std::convertible_to<U*, T*>
+        offset_ptr(const offset_ptr<U>& other) noexcept { set(other.get()); }
+
+        /// @brief Explicit downcasts (and casts from void), mirroring @c static_cast between raw pointers.
+        template<typename U> requires (!std::convertible_to<U*, T*> && requires(U* u) { static_cast<T*>(u); })
+        explicit offset_ptr(const offset_ptr<U>& other) noexcept { set(static_cast<T*>(other.get())); }
+
+        offset_ptr& operator=(const offset_ptr& other) noexcept {
+            set(other.get());
+            return *this;
+        }
+
+        offset_ptr& operator=(T* p) noexcept {
+            set(p);
+            return *this;
+        }
+
+        offset_ptr& operator=(std::nullptr_t) noexcept {
+            _off = null_offset;
+            return *this;
+        }
+
+        /**
+         * @brief The target as a raw pointer.
+         */
+        T* get() const noexcept {
+            if(_off == null_offset) { return nullptr; }
+            return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + static_cast<std::uintptr_t>(_off));
+        }
+
+        /**
+         * @brief The pointer to @p r (for @c std::pointer_traits).
+         */
+        template<typename U = T> requires (!std::is_void_v<U>)
+        static offset_ptr pointer_to(U& r) noexcept {
+            return offset_ptr{std::addressof(r)};
+        }
+
+        explicit operator bool() const noexcept { return _off != null_offset; }
+
+        reference operator*() const noexcept requires (!std::is_void_v<T>) { return *get(); }
+
+        T* operator->() const noexcept { return get(); }
+
+        reference operator[](difference_type i) const noexcept requires (!std::is_void_v<T>) { return get()[i]; }
+
+        offset_ptr& operator+=(difference_type n) noexcept requires (!std::is_void_v<T>) {
+            _off += n * static_cast<difference_type>(sizeof(T));
+            return *this;
+        }
+
+        offset_ptr& operator-=(difference_type n) noexcept requires (!std::is_void_v<T>) {
+            _off -= n * static_cast<difference_type>(sizeof(T));
+            return *this;
+        }
+
+        offset_ptr& operator++() noexcept requires (!std::is_void_v<T>) { return *this += 1; }
+
+        offset_ptr& operator--() noexcept requires (!std::is_void_v<T>) { return *this -= 1; }
+
+        offset_ptr operator++(int) noexcept requires (!std::is_void_v<T>) {
+            offset_ptr old {*this};
+            *this += 1;
+            return old;
+        }
+
+        offset_ptr operator--(int) noexcept requires (!std::is_void_v<T>) {
+            offset_ptr old {*this};
+            *this -= 1;
+            return old;
+        }
+
+        friend offset_ptr operator+(const offset_ptr& p, difference_type n) noexcept requires (!std::is_void_v<T>) {
+            return offset_ptr{p.get() + n};
+        }
+
+        friend offset_ptr operator+(difference_type n, const offset_ptr& p) noexcept requires (!std::is_void_v<T>) {
+            return offset_ptr{p.get() + n};
+        }
+
+        friend offset_ptr operator-(const offset_ptr& p, difference_type n) noexcept requires (!std::is_void_v<T>) {
+            return offset_ptr{p.get() - n};
+        }
+
+        friend difference_type operator-(const offset_ptr& a, const offset_ptr& b) noexcept requires (!std::is_void_v<T>) {
+            return a.get() - b.get();
+        }
+
+        friend bool operator==(const offset_ptr& a, const offset_ptr& b) noexcept { return a.get() == b.get(); }
+
+        friend bool operator==(const offset_ptr& a, std::nullptr_t) noexcept { return !a; }
+
+        friend std::strong_ordering operator<=>(const offset_ptr& a, const offset_ptr& b) noexcept {
+            return std::compare_three_way{}(a.get(), b.get());
+        }
+
+    private:
+
+        /// @brief The offset representing null (an offset of 0 is a pointer to the offset_ptr itself).
+        static constexpr std::ptrdiff_t null_offset {1};
+
+        /// @brief Distance in bytes from @c this to the target.
+        std::ptrdiff_t _off {null_offset};
+
+        void set(T* p) noexcept {
+            _off = p ? static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(p) - reinterpret_cast<std::uintptr_t>(this))
+                     : null_offset;
+        }
+    };
+
+    /**
+     * @brief Allocator drawing from an arena and handing out @c offset_ptr, for containers built relocatably.
+     *
+     * Every pointer a container keeps inside its allocations is then self-relative. The allocator's own handle to
+     * the arena is not; it is only needed while the container still allocates.
+     *
+     * @note Containers must support allocator pointer types other than @c T*; with libstdc++ 12 that holds for
+     *       vector and deque, but not basic_string or the node-based containers (list, map, ...).
+     *
+     * @tparam T The value type.
+     * @tparam Arena The arena type backing the allocator (default = @c arena).
+     */
+    template<typename T, bump_arena Arena = arena>
+    class offset_allocator {
+    public:
+        using value_type         = T;
+        using pointer            = offset_ptr<T>;
+        using const_pointer      = offset_ptr<const T>;
+        using void_pointer       = offset_ptr<void>;
+        using const_void_pointer = offset_ptr<const void>;
+        using size_type          = std::size_t;
+        using difference_type    = std::ptrdiff_t;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        using propagate_on_container_copy_assignment = std::true_type;
+
+        using is_always_equal = std::false_type;
+
+        template<typename U>
+        struct rebind {
+            using other = offset_allocator<U, Arena>;
+        };
+
+        offset_allocator() noexcept = default;
+        explicit offset_allocator(Arena& a) noexcept : _a{&a} {}
+
+        template<typename U>
+        offset_allocator(const offset_allocator<U, Arena>& other) noexcept : _a{other.arena_ptr()} {}
+
+        [[nodiscard]]
+        pointer allocate(std::size_t n) {
+            return pointer{basic_cma_allocator<T, Arena>{*checked()}.allocate(n)};
+        }
+
+        void deallocate(pointer p, std::size_t n) noexcept {
+            if(_a) { basic_cma_allocator<T, Arena>{*_a}.deallocate(p.get(), n); }
+        }
+
+        std::size_t max_size() const noexcept {
+            return std::numeric_limits<std::size_t>::max() / sizeof(T);
+        }
+
+        Arena* arena_ptr() const noexcept { return _a; }
+
+        template<typename U>
+        friend bool operator==(const offset_allocator& a, const offset_allocator<U, Arena>& b) noexcept {
+            return a.arena_ptr() == b.arena_ptr();
+        }
+
+    private:
+
+        Arena* _a {nullptr};
+
+        Arena* checked() const {
+            if(!_a) { throw std::bad_alloc{}; }
+            return _a;
+        }
+    };
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_PAGE_SIZE_H_INCLUDE
+#define CMA_PAGE_SIZE_H_INCLUDE
+
+#include <cstddef>
+
+#include <unistd.h>
+
+/*
+ * POSIX only.
+ *
+ * The system page size, shared by every header that maps memory or advises the kernel about pages, without them
+ * having to pull in one another.
+ */
+
+namespace cma {
+
+    namespace impl {
+
+        /**
+         * @brief Queries the system page size once.
+         */
+        inline std::size_t page_size() noexcept {
+            static const std::size_t size {static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))};
+            return size;
+        }
+
+    } // namespace impl
+
+} // namespace cma
+
+#endif
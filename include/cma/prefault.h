@@ -0,0 +1,100 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_PREFAULT_H_INCLUDE
+#define CMA_PREFAULT_H_INCLUDE
+
+#include <cma/cmalib.h>
+#include <cma/page_size.h>
+
+#include <sys/mman.h>
+
+/*
+ * POSIX only, with a Linux specific fast path.
+ *
+ * Fresh block storage is usually not backed by memory yet: each page faults in when the cursor first reaches it,
+ * so a large new block spreads hundreds of page faults over the allocations that follow it. Pre-faulting moves
+ * that cost to the moment the block is created, which together with @c basic_arena::reserve_blocks means the
+ * arena's construction (or any other point off the hot path).
+ *
+ * The pages are populated with MADV_POPULATE_WRITE (Linux >= 5.14) where possible, and otherwise by writing one
+ * byte per page.
+ */
+
+namespace cma {
+
+    namespace impl {
+
+        /**
+         * @brief Faults in every page of [p, p + bytes) for writing.
+         */
+        inline void prefault(void* p, std::size_t bytes) noexcept {
+            const std::size_t page {page_size()};
+            auto* first {static_cast<std::byte*>(p)};
+
+#if defined(MADV_POPULATE_WRITE)
+            std::byte* lo {align_up(first, page)};
+            std::byte* hi {first + bytes};
+            if(lo < hi && ::madvise(lo, static_cast<std::size_t>(hi - lo) & ~(page - 1), MADV_POPULATE_WRITE) == 0) {
+                // Only the partial page before the aligned range remains.
+                if(lo != first) { *static_cast<volatile std::byte*>(first) = std::byte{0}; }
+                if(static_cast<std::size_t>(hi - lo) % page != 0) { *static_cast<volatile std::byte*>(hi - 1) = std::byte{0}; }
+                return;
+            }
+#endif
+            for(std::size_t off {0}; off < bytes; off += page) {
+                *static_cast<volatile std::byte*>(first + off) = std::byte{0};
+            }
+            if(bytes != 0) { *static_cast<volatile std::byte*>(first + bytes - 1) = std::byte{0}; }
+        }
+
+    } // namespace impl
+
+    /**
+     * @brief Block source faulting in every page of a block before handing it to the arena.
+     * @tparam Upstream The block source storage is drawn from.
+     */
+    template<block_source Upstream = heap_block_source>
+    struct prefault_block_source {
+
+        /// @brief Base alignment of every block's storage (that of the upstream source).
+        static constexpr std::size_t alignment {impl::block_alignment<Upstream>()};
+
+        [[no_unique_address]] Upstream upstream {};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return upstream.round_size(bytes); }
+
+        void* allocate(std::size_t bytes) {
+            void* p {upstream.allocate(bytes)};
+            impl::prefault(p, bytes);
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept { upstream.deallocate(p, bytes); }
+    };
+
+    /**
+     * @brief Arena whose blocks are faulted in when created; combine with @c reserve_blocks at construction.
+     */
+    using prefault_arena = basic_arena<geometric_growth<>, prefault_block_source<>>;
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_SHARDED_ARENA_H_INCLUDE
+#define CMA_SHARDED_ARENA_H_INCLUDE
+
+#include <cma/concurrent_arena.h>
+
+#include <sched.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<sys/rseq.h>)
+#   include <sys/rseq.h>
+#endif
+
+/*
+ * Linux (other POSIX systems fall back to a single shard).
+ *
+ * A shared cursor, even a lock-free one, bounces one cache line between every allocating core. The sharded arena
+ * instead keeps one bump region ("chunk") per CPU, refilled in large chunks from a shared concurrent arena, so
+ * threads running on different CPUs never touch the same cursor.
+ *
+ * The CPU is read from the kernel-maintained rseq area registered by glibc (>= 2.35), a plain load, falling back to
+ * sched_getcpu(). Full restartable sequences would need per-architecture assembly for the critical section, so the
+ * per-CPU cursor is still bumped with a compare-and-swap; a thread migrated or preempted mid-allocation therefore
+ * stays correct, and the CAS is uncontended (its cache line stays local) in the common case.
+ */
+
+namespace cma {
+
+    namespace impl {
+
+        /**
+         * @brief Index of the CPU the calling thread is running on (a hint; the thread may migrate at any time).
+         */
+        inline unsigned current_cpu() noexcept {
+#if defined(__linux__) && defined(RSEQ_SIG) && __has_builtin(__builtin_thread_pointer)
+            if(__rseq_size > 0) {
+                const auto* rs {reinterpret_cast<const volatile struct rseq*>(
+                    static_cast<const char*>(__builtin_thread_pointer()) + __rseq_offset)};
+                return rs->cpu_id;
+            }
+#endif
+#if defined(__linux__)
+            const int cpu {::sched_getcpu()};
+            return cpu < 0 ? 0u : static_cast<unsigned>(cpu);
+#else
+            return 0;
+#endif
+        }
+
+    } // namespace impl
+
+    /**
+     * @brief Thread-safe arena with one bump region per CPU.
+     * @tparam GrowthPolicy The growth policy of the shared arena chunks are carved from.
+     * @tparam BlockSource The block source of the shared arena chunks are carved from.
+     */
+    template<growth_policy GrowthPolicy = geometric_growth<>, block_source BlockSource = heap_block_source>
+    class basic_sharded_arena {
+    public:
+
+        /**
+         * @brief Explicit ctor for a sharded arena.
+         * @param chunk_size The size of the region handed to a CPU at a time.
+         * @param initial_block_size The initial block size of the shared arena chunks are carved from.
+         * @param source The block source of the shared arena.
+         */
+        explicit basic_sharded_arena(std::size_t chunk_size = 64 * 1024, std::size_t initial_block_size = 1024 * 1024, BlockSource source = {})
+            : _chunk_size{std::max<std::size_t>(chunk_size, 4096)}
+            , _shard_count{shard_count_hint()}
+            , _shards{std::make_unique<shard[]>(_shard_count)}
+            , _shared{std::max(initial_block_size, _chunk_size * 2), std::move(source)}
+        {}
+
+        basic_sharded_arena(const basic_sharded_arena&) = delete;
+
+        basic_sharded_arena& operator=(const basic_sharded_arena&) = delete;
+
+        /**
+         * @brief Allocates bytes from the calling CPU's shard; safe to call from any number of threads.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The alignment of the allocation (default = max_align_t)
+         */
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if(bytes == 0) { return nullptr; }
+
+            if(alignment == 0 || !impl::is_pow_2(alignment)) {
+                alignment = alignof(std::max_align_t);
+            }
+
+            // Large requests would waste most of a chunk; serve them from the shared arena directly.
+            if(bytes > _chunk_size / 4) { return _shared.allocate_bytes(bytes, alignment); }
+
+            shard& s {_shards[impl::current_cpu() % _shard_count]};
+
+            for(;;) {
+                concurrent_block* c {s.chunk.load(std::memory_order_acquire)};
+                if(c) {
+                    if(void* p {c->try_alloc(bytes, alignment)}) { return p; }
+                }
+
+                refill(s, c);
+            }
+        }
+
+        /**
+         * @brief Arena object factory
+         * @tparam T The type to construct in the arena
+         * @tparam Args The constructor arg types to forward
+         * @param args The arguments to forward for construction
+         * @returns The pointer to the object constructed in the arena.
+         * @note Should construction throw, the storage is not reclaimed.
+         */
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+            return ::new (allocate_bytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Drops every shard's chunk and rewinds the shared arena, retaining its blocks.
+         * @warning No other thread may be allocating from the arena.
+         */
+        void reset() noexcept {
+            for(std::size_t i {0}; i < _shard_count; ++i) {
+                _shards[i].chunk.store(nullptr, std::memory_order_relaxed);
+            }
+
+            _shared.reset();
+        }
+
+        /// @brief Number of per-CPU shards.
+        std::size_t shard_count() const noexcept { return _shard_count; }
+
+    private:
+
+        /**
+         * @brief One CPU's bump region, on its own cache line.
+         */
+        struct alignas(64) shard {
+            std::atomic<concurrent_block*> chunk {nullptr};
+            std::mutex refill_mutex;
+        };
+
+        /// @brief The size of the region handed to a CPU at a time.
+        std::size_t _chunk_size {0};
+
+        /// @brief Number of shards (configured CPUs).
+        std::size_t _shard_count {1};
+
+        /// @brief The per-CPU shards.
+        std::unique_ptr<shard[]> _shards;
+
+        /// @brief The shared arena chunks (and large requests) are carved from.
+        basic_concurrent_arena<GrowthPolicy, BlockSource> _shared;
+
+        static std::size_t shard_count_hint() noexcept {
+            const long cpus {::sysconf(_SC_NPROCESSORS_CONF)};
+            return cpus > 0 ? static_cast<std::size_t>(cpus) : 1;
+        }
+
+        /**
+         * @brief Replaces the shard's (full) chunk @p seen with a fresh one, unless another thread already has.
+         */
+        void refill(shard& s, concurrent_block* seen) {
+            std::lock_guard lock{s.refill_mutex};
+            if(s.chunk.load(std::memory_order_relaxed) != seen) { return; }
+
+            void* storage {_shared.allocate_bytes(_chunk_size, alignof(std::max_align_t))};
+            s.chunk.store(::new (storage) concurrent_block(_chunk_size), std::memory_order_release);
+        }
+    };
+
+    /**
+     * @brief The default sharded arena, drawing blocks from the global heap.
+     */
+    using sharded_arena = basic_sharded_arena<>;
+
+} // namespace cma
+
+#endif
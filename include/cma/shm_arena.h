@@ -0,0 +1,297 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_SHM_ARENA_H_INCLUDE
+#define CMA_SHM_ARENA_H_INCLUDE
+
+#include <cma/offset_ptr.h>
+#include <cma/page_size.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * POSIX only (memfd_create on Linux, shm_open elsewhere).
+ *
+ * An arena in a shared memory segment that several processes map at once: producers build objects in place and
+ * consumers read them with no copy. The bump cursor lives in the segment's header as an atomic offset, so any
+ * process (and any thread) allocates with the same compare-and-swap as @c concurrent_arena, without a lock.
+ *
+ * The segment has a fixed size; growing it would require every process to remap it. Each process may map the
+ * segment at a different address, so objects link to each other with @c offset_ptr (or plain offsets), and are
+ * handed over by publishing a root offset (release) that the consumer reads (acquire).
+ */
+
+namespace cma {
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Cross-process cursors need lock-free atomics!");
+
+    /**
+     * @brief Header at the start of an @c shm_arena segment.
+     */
+    struct shm_header {
+
+        static constexpr std::uint64_t magic_value {0x4d48534d4143ull};   // "CAMSHM"
+
+        std::uint64_t magic {magic_value};
+
+        /// @brief Size of the whole segment (header included).
+        std::uint64_t size {0};
+
+        /// @brief Offset of the next free byte, bumped by every process.
+        alignas(64) std::atomic<std::uint64_t> cursor {0};
+
+        /// @brief Offset of the published root object (0 = none).
+        alignas(64) std::atomic<std::uint64_t> root {0};
+    };
+
+    /**
+     * @brief How an @c shm_arena opens a named segment.
+     */
+    enum class shm_mode {
+        create,     ///< Create (or truncate) the segment.
+        open,       ///< Map an existing segment.
+    };
+
+    /**
+     * @brief Arena in a shared memory segment, safe to allocate from in any number of processes and threads.
+     */
+    class shm_arena {
+    public:
+
+        /**
+         * @brief Creates an anonymous segment, shared with children forked after construction (or any process
+         *        the descriptor @c fd() is passed to).
+         * @param bytes The size of the segment (rounded to pages).
+         * @throws std::system_error if the segment cannot be created or mapped.
+         */
+        explicit shm_arena(std::size_t bytes) {
+#if defined(__linux__)
+            _fd = ::memfd_create("cma_shm_arena", MFD_CLOEXEC);
+            if(_fd < 0) { throw_errno("memfd_create"); }
+#else
+            char name[64];
+            std::snprintf(name, sizeof(name), "/cma_shm_arena.%ld.%p", static_cast<long>(::getpid()), static_cast<void*>(this));
+            _fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+            if(_fd < 0) { throw_errno("shm_open"); }
+            ::shm_unlink(name);
+#endif
+            init(bytes);
+        }
+
+        /**
+         * @brief Creates or opens a named (@c shm_open) segment.
+         * @param name The segment name ("/name").
+         * @param mode Whether to create the segment or map an existing one.
+         * @param bytes The size of the segment when creating (rounded to pages).
+         * @throws std::system_error if the segment cannot be opened or mapped; std::runtime_error if an opened
+         *         segment is not an arena.
+         */
+        shm_arena(const char* name, shm_mode mode, std::size_t bytes = 0) {
+            _fd = ::shm_open(name, mode == shm_mode::create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0600);
+            if(_fd < 0) { throw_errno("shm_open"); }
+
+            if(mode == shm_mode::create) {
+                init(bytes);
+            } else {
+                attach();
+            }
+        }
+
+        shm_arena(const shm_arena&) = delete;
+
+        shm_arena& operator=(const shm_arena&) = delete;
+
+        ~shm_arena() {
+            ::munmap(_base, _size);
+            ::close(_fd);
+        }
+
+        /**
+         * @brief Removes a named segment; processes that mapped it keep their mapping.
+         */
+        static void unlink(const char* name) noexcept { ::shm_unlink(name); }
+
+        /**
+         * @brief Allocates bytes in the segment; safe to call from any number of processes and threads.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The alignment of the allocation (default = max_align_t; at most the page size)
+         * @throws std::bad_alloc once the segment is exhausted, or if @p alignment exceeds the page size.
+         */
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if(bytes == 0) { return nullptr; }
+
+            if(alignment == 0 || !impl::is_pow_2(alignment)) {
+                alignment = alignof(std::max_align_t);
+            }
+
+            // Up to the page size, offsets are aligned like addresses, since the segment base is page aligned in
+            // every process; a stronger alignment could only hold in some processes' mappings.
+            if(alignment > impl::page_size()) { throw std::bad_alloc{}; }
+
+            std::uint64_t old {header().cursor.load(std::memory_order_relaxed)};
+            std::uint64_t aligned {0};
+
+            do {
+                aligned = impl::round_up(old, alignment);
+                if(aligned > _size || _size - aligned < bytes) { throw std::bad_alloc{}; }
+            } while(!header().cursor.compare_exchange_weak(old, aligned + bytes, std::memory_order_relaxed));
+
+            return _base + aligned;
+        }
+
+        /**
+         * @brief Arena object factory
+         * @tparam T The type to construct in the arena
+         * @tparam Args The constructor arg types to forward
+         * @param args The arguments to forward for construction
+         * @returns The pointer to the object constructed in the arena.
+         * @note Objects are never destroyed, and should link to each other with @c offset_ptr.
+         */
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+            return ::new (allocate_bytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Publishes @p object to other processes; everything written before is visible to a process that
+         *        observes it through @c root().
+         */
+        template<typename T>
+        void publish(const T* object) noexcept {
+            header().root.store(object ? offset_of(object) : 0, std::memory_order_release);
+        }
+
+        /**
+         * @brief The most recently published object, or @c nullptr.
+         */
+        template<typename T>
+        T* root() const noexcept {
+            const std::uint64_t off {header().root.load(std::memory_order_acquire)};
+            return off ? at<T>(off) : nullptr;
+        }
+
+        /// @brief Offset of @p p within the segment; the same in every process.
+        std::uint64_t offset_of(const void* p) const noexcept {
+            return static_cast<std::uint64_t>(static_cast<const std::byte*>(p) - _base);
+        }
+
+        /// @brief The object at @p offset within this process's mapping of the segment.
+        template<typename T>
+        T* at(std::uint64_t offset) const noexcept {
+            return reinterpret_cast<T*>(_base + offset);
+        }
+
+        /**
+         * @brief Rewinds the segment and clears the root.
+         * @warning No process may be using the segment.
+         */
+        void reset() noexcept {
+            header().root.store(0, std::memory_order_relaxed);
+            header().cursor.store(data_offset(), std::memory_order_release);
+        }
+
+        /// @brief The segment's descriptor, to pass to another process (e.g. over a Unix socket).
+        int fd() const noexcept { return _fd; }
+
+        /// @brief Start of this process's mapping of the segment.
+        std::byte* base() const noexcept { return _base; }
+
+        /// @brief Size of the segment (header included).
+        std::size_t size() const noexcept { return _size; }
+
+        /// @brief Number of bytes handed out, by every process (including alignment padding).
+        std::size_t used_bytes() const noexcept {
+            return static_cast<std::size_t>(header().cursor.load(std::memory_order_relaxed)) - data_offset();
+        }
+
+    private:
+
+        int _fd {-1};
+
+        std::byte* _base {nullptr};
+
+        std::size_t _size {0};
+
+        [[noreturn]] static void throw_errno(const char* what) {
+            throw std::system_error{errno, std::generic_category(), what};
+        }
+
+        static constexpr std::size_t data_offset() noexcept {
+            return impl::round_up(sizeof(shm_header), alignof(std::max_align_t));
+        }
+
+        shm_header& header() const noexcept { return *reinterpret_cast<shm_header*>(_base); }
+
+        void map(std::size_t bytes) {
+            void* p {::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0)};
+            if(p == MAP_FAILED) {
+                const int err {errno};
+                ::close(_fd);
+                throw std::system_error{err, std::generic_category(), "mmap"};
+            }
+
+            _base = static_cast<std::byte*>(p);
+            _size = bytes;
+        }
+
+        void init(std::size_t bytes) {
+            const std::size_t size {impl::round_up(std::max(bytes, data_offset() + 1), impl::page_size())};
+            if(::ftruncate(_fd, static_cast<off_t>(size)) != 0) {
+                const int err {errno};
+                ::close(_fd);
+                throw std::system_error{err, std::generic_category(), "ftruncate"};
+            }
+
+            map(size);
+
+            shm_header& h {*::new (_base) shm_header{}};
+            h.size = size;
+            h.cursor.store(data_offset(), std::memory_order_release);
+        }
+
+        void attach() {
+            struct stat st {};
+            if(::fstat(_fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(shm_header)) {
+                ::close(_fd);
+                throw std::runtime_error{"cma::shm_arena: not an arena segment"};
+            }
+
+            map(static_cast<std::size_t>(st.st_size));
+
+            if(header().magic != shm_header::magic_value || header().size != _size) {
+                ::munmap(_base, _size);
+                ::close(_fd);
+                throw std::runtime_error{"cma::shm_arena: not an arena segment"};
+            }
+        }
+    };
+
+} // namespace cma
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2026, Brandon M. Tharp
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_MSC_VER) || defined(__clang__) || defined(__GNUC__)
+#   pragma once
+#endif
+
+#ifndef CMA_VIRTUAL_ARENA_H_INCLUDE
+#define CMA_VIRTUAL_ARENA_H_INCLUDE
+
+#include <cma/cmalib.h>
+#include <cma/page_size.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * POSIX only; the arena is built directly on mmap/mprotect.
+ *
+ * Rather than chaining blocks, a single (large) range of address space is reserved up front with no access
+ * rights. Pages are committed (made read/write) in fixed-size steps as the cursor advances, so the base address
+ * never changes, no tail space is ever abandoned, and the whole state of the arena is a single pointer.
+ */
+
+namespace cma {
+
+    /**
+     * @brief Arena over a single reserved range of virtual memory, committed on demand.
+     */
+    class virtual_arena {
+    public:
+
+        /**
+         * @brief Marker used to roll-back some of the memory in the arena.
+         * @note Since the arena is contiguous, the cursor alone identifies a position.
+         */
+        struct marker {
+            std::byte* cur {nullptr};
+        };
+
+        /**
+         * @brief Explicit ctor reserving (but not committing) the arena's address range.
+         * @param reserve_bytes The size of the address range to reserve (default = 64 GiB).
+         * @param commit_granularity The minimum number of bytes committed at a time (rounded to pages).
+         * @throws std::bad_alloc if the address range cannot be reserved.
+         */
+        explicit virtual_arena(std::size_t reserve_bytes = std::size_t{64} << 30, std::size_t commit_granularity = 64 * 1024)
+            : _granularity{impl::round_up(std::max(commit_granularity, impl::page_size()), impl::page_size())}
+        {
+            const std::size_t bytes {impl::round_up(std::max(reserve_bytes, _granularity), _granularity)};
+            if(bytes == 0) { throw std::bad_alloc{}; }
+
+            void* p {::mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+            if(p == MAP_FAILED) { throw std::bad_alloc{}; }
+
+            _base = static_cast<std::byte*>(p);
+            _cur = _base;
+            _committed = _base;
+            _end = _base + bytes;
+        }
+
+        virtual_arena(const virtual_arena&) = delete;
+
+        virtual_arena& operator=(const virtual_arena&) = delete;
+
+        ~virtual_arena() { ::munmap(_base, static_cast<std::size_t>(_end - _base)); }
+
+        /**
+         * @brief Main function to allocate bytes in the arena.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The alignment of the allocation (default = max_align_t)
+         * @throws std::bad_alloc once the reservation is exhausted or pages cannot be committed.
+         */
+        void* allocate_bytes(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            if(bytes == 0) { return nullptr; }
+
+            if(alignment == 0 || !impl::is_pow_2(alignment)) {
+                alignment = alignof(std::max_align_t);
+            }
+
+            std::byte* aligned {impl::align_up(_cur, alignment)};
+
+            // Only crossing the committed boundary leaves the fast path.
+            if(aligned > _committed || static_cast<std::size_t>(_committed - aligned) < bytes) {
+                if(aligned > _end || static_cast<std::size_t>(_end - aligned) < bytes) { throw std::bad_alloc{}; }
+                commit(aligned + bytes);
+            }
+
+            _cur = aligned + bytes;
+            return aligned;
+        }
+
+        /**
+         * @brief Grows the most recent allocation in place (see @c basic_arena::try_extend), committing pages as needed.
+         * @returns Whether @p p now spans @p new_size bytes.
+         */
+        bool try_extend(void* p, std::size_t old_size, std::size_t new_size) noexcept {
+            auto* b {static_cast<std::byte*>(p)};
+            if(b < _base || b > _cur || static_cast<std::size_t>(_cur - b) != old_size || new_size < old_size) { return false; }
+            if(static_cast<std::size_t>(_end - b) < new_size) { return false; }
+
+            if(static_cast<std::size_t>(_committed - b) < new_size) {
+                try {
+                    commit(b + new_size);
+                } catch (const std::bad_alloc&) {
+                    return false;
+                }
+            }
+
+            _cur = b + new_size;
+            return true;
+        }
+
+        /**
+         * @brief Shrinks the most recent allocation in place (see @c basic_arena::try_shrink).
+         * @returns Whether the tail was reclaimed.
+         */
+        bool try_shrink(void* p, std::size_t old_size, std::size_t new_size) noexcept {
+            auto* b {static_cast<std::byte*>(p)};
+            if(b < _base || b > _cur || static_cast<std::size_t>(_cur - b) != old_size || new_size > old_size) { return false; }
+
+            _cur = b + new_size;
+            return true;
+        }
+
+        /**
+         * @brief Creates a marker at the current cursor.
+         * @returns The marker at the specified location.
+         */
+        marker create_marker() const noexcept {
+            return marker{_cur};
+        }
+
+        /**
+         * @brief Reverts the state of the allocation in the arena to a given marker.
+         * @param m The marker to revert to.
+         * @note Committed pages are kept for reuse.
+         */
+        void rollback_to(const marker& m) noexcept {
+            if(!m.cur) { return; }
+            _cur = m.cur;
+        }
+
+        /**
+         * @brief Rewinds the arena to its base, keeping all committed pages.
+         */
+        void reset() noexcept {
+            _cur = _base;
+        }
+
+        /**
+         * @brief Rewinds the arena and decommits pages beyond a retained byte budget.
+         * @param retained_bytes Number of committed bytes to keep (rounded up to the commit granularity).
+         */
+        void release(std::size_t retained_bytes = 0) noexcept {
+            _cur = _base;
+
+            // Clamped before rounding, so budgets near SIZE_MAX (keep everything) cannot wrap around to 0.
+            const std::size_t committed {committed_bytes()};
+            const std::size_t keep {std::min(impl::round_up(std::min(retained_bytes, committed), _granularity), committed)};
+            std::byte* from {_base + keep};
+
+            if(from < _committed) {
+                const auto len {static_cast<std::size_t>(_committed - from)};
+                ::madvise(from, len, MADV_DONTNEED);
+                ::mprotect(from, len, PROT_NONE);
+                _committed = from;
+            }
+        }
+
+        /**
+         * @brief Arena object factory
+         * @tparam T The type to construct in the arena
+         * @tparam Args The constructor arg types to forward
+         * @param args The arguments to forward for construction
+         * @returns The pointer to the object constructed in the arena.
+         */
+        template<typename T, typename... Args>
+        T* make(Args&&... args) {
+            static_assert(!std::is_void_v<T>, "T cannot be void!");
+
+            const marker m {create_marker()};
+            void* memory {allocate_bytes(sizeof(T), alignof(T))};
+
+            try {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            } catch (...) {
+                rollback_to(m);
+                throw;
+            }
+        }
+
+        /// @brief Start of the reserved range; stable for the lifetime of the arena.
+        std::byte* base() const noexcept { return _base; }
+
+        /// @brief Number of bytes handed out since the base (including alignment padding).
+        std::size_t used_bytes() const noexcept { return static_cast<std::size_t>(_cur - _base); }
+
+        /// @brief Number of bytes currently committed (read/write).
+        std::size_t committed_bytes() const noexcept { return static_cast<std::size_t>(_committed - _base); }
+
+        /// @brief Size of the reserved address range.
+        std::size_t reserved_bytes() const noexcept { return static_cast<std::size_t>(_end - _base); }
+
+    private:
+
+        /// @brief Start of the reserved range.
+        std::byte* _base        {nullptr};
+
+        /// @brief Next free byte; [base, committed].
+        std::byte* _cur         {nullptr};
+
+        /// @brief One past the last committed byte.
+        std::byte* _committed   {nullptr};
+
+        /// @brief One past the last reserved byte.
+        std::byte* _end         {nullptr};
+
+        /// @brief Minimum number of bytes committed per step (multiple of the page size).
+        std::size_t _granularity {0};
+
+        /**
+         * @brief Commits pages such that [base, upto) is read/write.
+         * @param upto The first byte that does not need to be committed (<= end).
+         * @throws std::bad_alloc if the pages cannot be committed.
+         */
+        void commit(std::byte* upto) {
+            const auto want {impl::round_up(static_cast<std::size_t>(upto - _base), _granularity)};
+            std::byte* target {_base + std::min(want, reserved_bytes())};
+
+            if(::mprotect(_committed, static_cast<std::size_t>(target - _committed), PROT_READ | PROT_WRITE) != 0) {
+                throw std::bad_alloc{};
+            }
+
+            _committed = target;
+        }
+    };
+
+} // namespace cma
+
+#endif
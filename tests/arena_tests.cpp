@@ -0,0 +1,393 @@
+#include <gtest/gtest.h>
+#include <cma/cmalib.h>
+
+#include "counting_source.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    template<cma::growth_policy GrowthPolicy = cma::geometric_growth<>>
+    using counted_arena = cma::basic_arena<GrowthPolicy, cma_test::counting_source>;
+}
+
+TEST(cma_arena, rollback_reuses_blocks) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    const auto m {a.create_marker()};
+
+    // Warm-up cycle grows the chain to its steady-state size.
+    for(int i {0}; i < 64; ++i) { a.allocate_bytes(512); }
+    a.rollback_to(m);
+
+    const std::size_t before {blocks.allocated};
+    for(int cycle {0}; cycle < 1000; ++cycle) {
+        for(int i {0}; i < 64; ++i) { ASSERT_NE(a.allocate_bytes(512), nullptr); }
+        a.rollback_to(m);
+    }
+    EXPECT_EQ(blocks.allocated, before);
+}
+
+TEST(cma_arena, rollback_skips_small_blocks) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    const auto m {a.create_marker()};
+    a.allocate_bytes(1000);
+    a.allocate_bytes(1000); // grows into a 2 KiB block
+    a.rollback_to(m);
+
+    const std::size_t before {blocks.allocated};
+    a.allocate_bytes(1000);
+    EXPECT_NE(a.allocate_bytes(1500), nullptr); // only fits in the 2 KiB block already owned
+    EXPECT_EQ(blocks.allocated, before);
+}
+
+TEST(cma_arena, reset_retains_blocks) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    for(int i {0}; i < 64; ++i) { a.allocate_bytes(512); }
+    a.reset();
+
+    const std::size_t before {blocks.allocated};
+    for(int cycle {0}; cycle < 1000; ++cycle) {
+        for(int i {0}; i < 64; ++i) { ASSERT_NE(a.allocate_bytes(512), nullptr); }
+        a.reset();
+    }
+    EXPECT_EQ(blocks.allocated, before);
+}
+
+TEST(cma_arena, release_trims_to_budget) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    a.allocate_bytes(1000);
+    a.allocate_bytes(1000); // 2 KiB block
+    a.allocate_bytes(3000); // 4 KiB block
+    a.release(2048);
+
+    const std::size_t before {blocks.allocated};
+    a.allocate_bytes(1000);
+    a.allocate_bytes(1500); // fits the retained 2 KiB block
+    EXPECT_EQ(blocks.allocated, before);
+    a.allocate_bytes(3000); // the 4 KiB block was freed
+    EXPECT_GT(blocks.allocated, before);
+
+    a.release();
+    const std::size_t head_only {blocks.allocated};
+    a.allocate_bytes(1000);
+    a.allocate_bytes(1000);
+    EXPECT_GT(blocks.allocated, head_only);
+}
+
+TEST(cma_arena, block_is_single_allocation) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    EXPECT_EQ(blocks.allocated, 1u);
+
+    a.allocate_bytes(5000);
+    EXPECT_EQ(blocks.allocated, 2u);
+}
+
+TEST(cma_arena, block_source_owns_storage) {
+    cma_test::block_counts blocks {};
+    {
+        counted_arena<> a{1024, {&blocks}};
+        EXPECT_EQ(blocks.live, 1u);
+        a.allocate_bytes(5000);
+        EXPECT_EQ(blocks.live, 2u);
+        a.release();
+        EXPECT_EQ(blocks.live, 1u);
+        a.allocate_bytes(5000);
+    }
+    EXPECT_EQ(blocks.live, 0u);
+}
+
+TEST(cma_growth, shipped_policies) {
+    constexpr cma::geometric_growth<2, 8192> capped {};
+    EXPECT_EQ(capped.next_capacity(1024, 100, 1024), 2048u);
+    EXPECT_EQ(capped.next_capacity(8192, 100, 1024), 8192u);
+    EXPECT_EQ(capped.next_capacity(8192, 20000, 1024), 20000u);
+
+    constexpr cma::fixed_growth fixed {};
+    EXPECT_EQ(fixed.next_capacity(1 << 20, 100, 4096), 4096u);
+
+    cma::page_rounded_growth<cma::fixed_growth> paged {};
+    const std::size_t cap {paged.next_capacity(0, 100, 5000)};
+    EXPECT_GE(cap, 5000u);
+    EXPECT_EQ((cap + cma::block::header_size()) % 4096, 0u);
+}
+
+TEST(cma_growth, learned_policy_sizes_from_last_cycle) {
+    cma_test::block_counts blocks {};
+    counted_arena<cma::learned_growth<>> a{1024, {&blocks}};
+    for(int i {0}; i < 200; ++i) { a.allocate_bytes(512); }
+    a.release();
+
+    const std::size_t before {blocks.allocated};
+    for(int i {0}; i < 200; ++i) { a.allocate_bytes(512); }
+    EXPECT_EQ(blocks.allocated, before + 1);
+}
+
+TEST(cma_growth, learned_policy_counts_rolled_back_scopes) {
+    cma_test::block_counts blocks {};
+    counted_arena<cma::learned_growth<>> a{1024, {&blocks}};
+    const auto m {a.create_marker()};
+    for(int i {0}; i < 200; ++i) { a.allocate_bytes(512); }
+    a.rollback_to(m);
+
+    EXPECT_EQ(a.bytes_in_use(), 0u);
+    EXPECT_GE(a.peak_bytes_in_use(), 200u * 512);
+    a.release();
+
+    const std::size_t before {blocks.allocated};
+    for(int i {0}; i < 200; ++i) { a.allocate_bytes(512); }
+    EXPECT_EQ(blocks.allocated, before + 1);
+}
+
+TEST(cma_growth, learned_policy_counts_freed_top_allocations) {
+    cma_test::block_counts blocks {};
+    counted_arena<cma::learned_growth<>> a{1024, {&blocks}};
+    cma::basic_cma_resource r{a};
+
+    // The buffer is the top allocation, so freeing it hands its bytes back before the cycle ends.
+    {
+        std::pmr::vector<std::byte> v{&r};
+        v.resize(200 * 512);
+    }
+    EXPECT_EQ(a.bytes_in_use(), 0u);
+    EXPECT_GE(a.peak_bytes_in_use(), 200u * 512);
+    a.release();
+
+    const std::size_t before {blocks.allocated};
+    for(int i {0}; i < 200; ++i) { a.allocate_bytes(512); }
+    EXPECT_EQ(blocks.allocated, before + 1);
+}
+
+TEST(cma_arena, extend_and_shrink_top_allocation) {
+    cma::arena a{4096};
+    void* first {a.allocate_bytes(64)};
+    void* top {a.allocate_bytes(64)};
+
+    EXPECT_FALSE(a.try_extend(first, 64, 128));
+    EXPECT_TRUE(a.try_extend(top, 64, 1024));
+    EXPECT_FALSE(a.try_extend(top, 1024, 1 << 20));
+    EXPECT_TRUE(a.try_shrink(top, 1024, 32));
+    EXPECT_EQ(static_cast<std::byte*>(a.allocate_bytes(16, 16)), static_cast<std::byte*>(top) + 32);
+
+    const std::size_t used {a.bytes_in_use()};
+    void* last {a.allocate_bytes(256)};
+    EXPECT_TRUE(a.try_shrink(last, 256, 0));
+    EXPECT_EQ(a.bytes_in_use(), used);
+}
+
+TEST(cma_pmr_adaptor, deallocate_reclaims_top) {
+    cma::arena a{};
+    cma::cma_resource r{a};
+
+    void* p {r.allocate(100, 8)};
+    void* q {r.allocate(100, 8)};
+    const std::size_t used {a.bytes_in_use()};
+
+    r.deallocate(p, 100, 8); // not the top allocation; nothing to reclaim
+    EXPECT_EQ(a.bytes_in_use(), used);
+
+    r.deallocate(q, 100, 8);
+    EXPECT_EQ(a.bytes_in_use(), used - 100);
+    EXPECT_EQ(r.allocate(100, 8), q);
+}
+
+namespace {
+    struct tracked {
+        std::vector<int>* log;
+        int id;
+
+        tracked(std::vector<int>* l, int i) : log{l}, id{i} {}
+        ~tracked() { log->push_back(id); }
+    };
+
+    struct throws_on_construct {
+        std::string s {"owned"};
+        throws_on_construct() { throw std::runtime_error{"ctor"}; }
+    };
+}
+
+TEST(cma_arena, make_runs_destructors) {
+    std::vector<int> log;
+    {
+        cma::arena a{};
+        a.make<tracked>(&log, 1);
+        const auto m {a.create_marker()};
+        a.make<tracked>(&log, 2);
+        a.make<tracked>(&log, 3);
+
+        a.rollback_to(m);
+        EXPECT_EQ(log, (std::vector<int>{3, 2}));
+
+        a.make<tracked>(&log, 4);
+        a.reset();
+        EXPECT_EQ(log, (std::vector<int>{3, 2, 4, 1}));
+
+        a.make<tracked>(&log, 5);
+        auto* s {a.make<std::string>(1000, 'x')};
+        EXPECT_EQ(s->size(), 1000u);
+    }
+    EXPECT_EQ(log, (std::vector<int>{3, 2, 4, 1, 5}));
+}
+
+TEST(cma_arena, make_trivial_types_register_nothing) {
+    cma::arena a{};
+    const std::size_t used {a.bytes_in_use()};
+    a.make<std::uint64_t>(1u);
+    EXPECT_EQ(a.bytes_in_use(), used + sizeof(std::uint64_t));
+
+    EXPECT_THROW(a.make<throws_on_construct>(), std::runtime_error);
+    EXPECT_EQ(a.bytes_in_use(), used + sizeof(std::uint64_t));
+}
+
+TEST(cma_arena, array_factories) {
+    cma::arena a{};
+    auto zeros {a.make_array<int>(1000)};
+    ASSERT_EQ(zeros.size(), 1000u);
+    EXPECT_TRUE(std::ranges::all_of(zeros, [](int v) { return v == 0; }));
+
+    auto filled {a.make_array<std::uint32_t>(100, 0x01020304u)};
+    EXPECT_TRUE(std::ranges::all_of(filled, [](std::uint32_t v) { return v == 0x01020304u; }));
+    auto ones {a.make_array<int>(100, -1)};
+    EXPECT_TRUE(std::ranges::all_of(ones, [](int v) { return v == -1; }));
+
+    EXPECT_EQ(a.make_uninitialized_array<double>(64).size(), 64u);
+    EXPECT_TRUE(a.make_array<int>(0).empty());
+    EXPECT_THROW(a.make_array<std::uint64_t>(std::numeric_limits<std::size_t>::max() / 4), std::bad_alloc);
+
+    const std::vector<std::string> source {"a", "bb", "ccc"};
+    auto copy {a.make_span(source)};
+    EXPECT_TRUE(std::ranges::equal(copy, source));
+
+    const std::vector<int> ints {1, 2, 3, 4};
+    auto int_copy {a.make_span(ints)};
+    EXPECT_TRUE(std::ranges::equal(int_copy, ints));
+}
+
+namespace {
+    struct throws_at_third {
+        static inline int constructed {0};
+        static inline int destroyed {0};
+
+        throws_at_third() {
+            if(constructed == 2) { throw std::runtime_error{"third"}; }
+            ++constructed;
+        }
+        ~throws_at_third() { ++destroyed; }
+    };
+}
+
+TEST(cma_arena, array_rolls_back_as_whole) {
+    cma::arena a{};
+    const std::size_t used {a.bytes_in_use()};
+
+    EXPECT_THROW(a.make_array<throws_at_third>(5), std::runtime_error);
+    EXPECT_EQ(throws_at_third::destroyed, 2);
+    EXPECT_EQ(a.bytes_in_use(), used);
+
+    std::vector<int> log;
+    {
+        cma::arena b{};
+        auto span {b.make_span(std::vector<tracked>{{&log, 1}, {&log, 2}})};
+        log.clear();
+        EXPECT_EQ(span.size(), 2u);
+    }
+    EXPECT_EQ(log, (std::vector<int>{2, 1}));
+}
+
+TEST(cma_arena, over_aligned_blocks) {
+    using page_arena = cma::basic_arena<cma::fixed_growth, cma::aligned_block_source<4096>, cma::counting_stats>;
+    static_assert(page_arena::base_alignment == 4096);
+    static_assert(page_arena::header_bytes == 0);
+
+    page_arena a{4096};
+    for(int i {0}; i < 8; ++i) {
+        void* p {a.allocate_bytes(4096, 4096)};
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 4096, 0u);
+    }
+    EXPECT_EQ(a.bytes_in_use(), 8 * 4096u); // no padding, every block holds exactly one page
+    EXPECT_EQ(a.footprint_bytes(), 8 * 4096u);
+    EXPECT_EQ(a.snapshot().blocks_allocated, 8u);
+    EXPECT_EQ(a.snapshot().abandoned_bytes, 0u);
+
+    // Page rounding accounts for the header living outside the pages.
+    using rounded_arena = cma::basic_arena<cma::page_rounded_growth<cma::fixed_growth>, cma::aligned_block_source<4096>>;
+    rounded_arena r{5000};
+    EXPECT_EQ(r.footprint_bytes(), 8192u);
+
+    using line_arena = cma::basic_arena<cma::geometric_growth<>, cma::aligned_block_source<64>>;
+    line_arena b{};
+    void* first {b.allocate_bytes(100, 64)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 64, 0u);
+    EXPECT_EQ(b.bytes_in_use(), 100u);
+}
+
+TEST(cma_arena, over_aligned_requests_in_default_arena) {
+    cma::arena a{1024};
+    a.allocate_bytes(1, 1);
+    void* p {a.allocate_bytes(512, 256)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 256, 0u);
+
+    void* big {a.allocate_bytes(64 * 1024, 4096)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 4096, 0u);
+}
+
+TEST(cma_arena, statistics_policy) {
+    static_assert(sizeof(cma::arena) == sizeof(cma::basic_arena<cma::geometric_growth<>, cma::heap_block_source, cma::no_stats>));
+
+    using stats_arena = cma::basic_arena<cma::fixed_growth, cma::heap_block_source, cma::counting_stats>;
+    stats_arena a{1024};
+
+    a.allocate_bytes(1, 1);
+    a.allocate_bytes(8, 8);             // 7 bytes of padding
+    a.allocate_bytes(1024, 8);          // does not fit the first block; abandons its tail
+
+    const cma::arena_stats s {a.snapshot()};
+    EXPECT_EQ(s.allocations, 3u);
+    EXPECT_EQ(s.bytes_requested, 1033u);
+    EXPECT_EQ(s.padding_bytes, 7u);
+    EXPECT_EQ(s.abandoned_bytes, 1024u - 16u);
+    EXPECT_EQ(s.blocks_allocated, 2u);
+    EXPECT_EQ(s.footprint_bytes, 2 * (1024u + cma::block::header_size()));
+
+    a.release();
+    EXPECT_EQ(a.snapshot().footprint_bytes, 1024u + cma::block::header_size());
+    EXPECT_EQ(a.snapshot().peak_footprint_bytes, 2 * (1024u + cma::block::header_size()));
+}
+
+TEST(cma_pmr_adaptor, resource_reports_deallocations) {
+    using stats_arena = cma::basic_arena<cma::geometric_growth<>, cma::heap_block_source, cma::counting_stats>;
+    stats_arena a{};
+    cma::basic_cma_resource<stats_arena> r{a};
+
+    void* p {r.allocate(64, 8)};
+    void* q {r.allocate(32, 8)};
+    r.deallocate(p, 64, 8);
+    r.deallocate(q, 32, 8);
+
+    const cma::arena_stats s {a.snapshot()};
+    EXPECT_EQ(s.allocations, 2u);
+    EXPECT_EQ(s.deallocations, 2u);
+    EXPECT_EQ(s.bytes_deallocated, 96u);
+    EXPECT_EQ(s.bytes_reclaimed, 32u);
+}
+
+TEST(cma_arena, reserve_blocks_follows_growth) {
+    cma_test::block_counts blocks {};
+    counted_arena<> a{1024, {&blocks}};
+    a.reserve_blocks(2);        // 2 KiB and 4 KiB blocks, with geometric growth
+
+    const std::size_t before {blocks.allocated};
+    a.allocate_bytes(1024, 1);
+    a.allocate_bytes(2048, 1);
+    a.allocate_bytes(4096, 1);
+    EXPECT_EQ(blocks.allocated, before);
+    EXPECT_EQ(a.bytes_in_use(), 1024u + 2048u + 4096u);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <cma/async_refill.h>
+
+#include <cstring>
+
+namespace {
+    using fixed_async_arena = cma::basic_arena<cma::fixed_growth, cma::async_block_source<>, cma::counting_stats>;
+
+    constexpr std::size_t block {64 * 1024};
+}
+
+TEST(cma_async_refill, next_block_is_handed_over) {
+    fixed_async_arena a{block};
+    EXPECT_EQ(a.source().stats().blocking, 1u);     // the first block, at construction
+
+    // Crossing the fill threshold asks for the next block but keeps using the active one.
+    auto* first {static_cast<std::byte*>(a.allocate_bytes(block / 4))};
+    auto* second {static_cast<std::byte*>(a.allocate_bytes(block / 2))};
+    EXPECT_EQ(second, first + block / 4);
+    EXPECT_EQ(a.snapshot().blocks_allocated, 1u);
+
+    EXPECT_TRUE(a.source().wait_prepared());
+
+    std::memset(a.allocate_bytes(block / 2), 0x5A, block / 2);
+    EXPECT_EQ(a.snapshot().blocks_allocated, 2u);
+    EXPECT_EQ(a.source().stats().handoffs, 1u);
+    EXPECT_EQ(a.source().stats().blocking, 1u);
+}
+
+TEST(cma_async_refill, every_block_is_accounted_for) {
+    fixed_async_arena a{block};
+
+    // Whether the helper keeps up or not, every block after the first comes from it (ready, or waited for).
+    for(int i {0}; i < 30; ++i) {
+        std::memset(a.allocate_bytes(block / 3), i, block / 3);
+    }
+
+    const cma::async_refill_stats s {a.source().stats()};
+    EXPECT_EQ(s.handoffs + s.waits + s.blocking, a.snapshot().blocks_allocated);
+    EXPECT_EQ(s.blocking, 1u);
+}
+
+TEST(cma_async_refill, prepared_blocks_are_handed_over_ready) {
+    fixed_async_arena a{block};
+
+    for(int i {0}; i < 30; ++i) {
+        std::memset(a.allocate_bytes(block / 3), i, block / 3);
+        a.source().wait_prepared();
+    }
+
+    const cma::async_refill_stats s {a.source().stats()};
+    EXPECT_EQ(s.handoffs, a.snapshot().blocks_allocated - 1);
+    EXPECT_EQ(s.waits, 0u);
+    EXPECT_EQ(s.blocking, 1u);
+}
+
+TEST(cma_async_refill, oversized_requests_allocate_synchronously) {
+    fixed_async_arena a{block};
+    a.allocate_bytes(block * 3 / 4);
+    EXPECT_TRUE(a.source().wait_prepared());
+
+    // The prepared block is too small, so it is dropped and the arena's own request is served directly.
+    std::memset(a.allocate_bytes(block * 4), 1, block * 4);
+    EXPECT_EQ(a.source().stats().handoffs, 0u);
+    EXPECT_EQ(a.source().stats().blocking, 2u);
+}
+
+TEST(cma_async_refill, rollback_and_reset_keep_the_threshold) {
+    cma::async_arena a{block};
+
+    const auto m {a.create_marker()};
+    for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+    a.rollback_to(m);
+    for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+    a.reset();
+
+    auto* p {static_cast<std::byte*>(a.allocate_bytes(16))};
+    EXPECT_TRUE(a.try_extend(p, 16, block / 2));
+}
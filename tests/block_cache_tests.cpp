@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <cma/block_cache.h>
+
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+    // A distinct upstream type gives these tests their own process-wide cache.
+    struct test_upstream : cma::heap_block_source {};
+
+    using cache = cma::block_cache<test_upstream>;
+    using test_arena = cma::basic_arena<cma::geometric_growth<>, cma::cached_block_source<test_upstream>>;
+}
+
+TEST(cma_block_cache, size_classes) {
+    EXPECT_EQ(cache::round_size(1), 4096u);
+    EXPECT_EQ(cache::round_size(4097), 5120u);
+    EXPECT_EQ(cache::round_size(64 * 1024 + 48), 80 * 1024u);
+    EXPECT_EQ(cache::round_size(128 * 1024), 128 * 1024u);
+    EXPECT_EQ(cache::round_size((std::size_t{1} << 30) + 1), (std::size_t{1} << 30) + 1);
+}
+
+TEST(cma_block_cache, arenas_reuse_cached_blocks) {
+    cache::instance().trim();
+    const auto before {cache::instance().stats()};
+
+    for(int i {0}; i < 100; ++i) {
+        test_arena a{};
+        a.allocate_bytes(100 * 1024);
+    }
+
+    const auto after {cache::instance().stats()};
+    EXPECT_EQ(after.misses - before.misses, 2u);
+    EXPECT_EQ(after.front_hits - before.front_hits, 198u);
+    EXPECT_GT(after.cached_bytes, 0u);
+
+    cache::instance().trim();
+    EXPECT_EQ(cache::instance().stats().cached_bytes, 0u);
+}
+
+TEST(cma_block_cache, exiting_thread_flushes_to_back) {
+    cache::instance().trim();
+    std::thread{[] { test_arena a{}; }}.join();
+
+    const auto before {cache::instance().stats()};
+    test_arena a{};
+    EXPECT_EQ(cache::instance().stats().back_hits, before.back_hits + 1);
+    EXPECT_EQ(cache::instance().stats().misses, before.misses);
+}
+
+TEST(cma_block_cache, limit_covers_front_caches) {
+    cache& c {cache::instance()};
+    c.trim();
+    c.set_limit(256 * 1024);
+
+    std::vector<void*> blocks {};
+    for(int i {0}; i < 4; ++i) { blocks.push_back(c.acquire(128 * 1024)); }
+    for(void* p : blocks) { c.release(p, 128 * 1024); }
+
+    // Only two blocks fit under the limit, although the front cache has room for four.
+    EXPECT_EQ(c.stats().cached_bytes, 256 * 1024u);
+
+    c.set_limit(std::size_t{256} << 20);
+    c.trim();
+}
+
+TEST(cma_block_cache, front_cache_is_bounded_in_bytes) {
+    cache& c {cache::instance()};
+    c.trim();
+
+    constexpr std::size_t block {std::size_t{16} << 20};
+    std::vector<void*> blocks {};
+    for(int i {0}; i < 4; ++i) { blocks.push_back(c.acquire(block)); }
+    for(void* p : blocks) { c.release(p, block); }
+
+    // The front cache takes two (front_limit), the rest go to the back cache.
+    const auto before {c.stats()};
+    for(int i {0}; i < 4; ++i) { blocks[i] = c.acquire(block); }
+    EXPECT_EQ(c.stats().front_hits - before.front_hits, 2u);
+    EXPECT_EQ(c.stats().back_hits - before.back_hits, 2u);
+
+    for(void* p : blocks) { c.release(p, block); }
+    c.trim();
+}
+
+TEST(cma_block_cache, trim_reaches_other_threads_front_caches) {
+    cache& c {cache::instance()};
+    c.trim();
+
+    std::promise<void> filled {};
+    std::promise<void> trimmed {};
+
+    std::thread worker {[&] {
+        c.release(c.acquire(64 * 1024), 64 * 1024);
+        filled.set_value();
+
+        trimmed.get_future().wait();
+        c.release(c.acquire(4096), 4096);     // next use: the trimmed front is emptied first
+    }};
+
+    filled.get_future().wait();
+    EXPECT_EQ(c.stats().cached_bytes, 64 * 1024u);
+
+    c.trim();
+    trimmed.set_value();
+    worker.join();
+
+    // Only the worker's last block is left, flushed to the back cache as the thread exited.
+    EXPECT_EQ(c.stats().cached_bytes, 4096u);
+    c.trim();
+    EXPECT_EQ(c.stats().cached_bytes, 0u);
+}
+
+TEST(cma_block_cache, static_arena_returns_blocks_at_exit) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+    EXPECT_EXIT({
+        cache::instance().trim();
+
+        // Registered first, so it runs after the static arena below is destroyed: by then the main thread's
+        // front cache is gone too, and the arena's block must have gone to the back cache.
+        std::atexit([] {
+            cache& c {cache::instance()};
+            const auto before {c.stats()};
+
+            const std::size_t bytes {cache::round_size(64 * 1024 + cma::block::header_size())};
+            c.release(c.acquire(bytes), bytes);
+            std::_Exit(c.stats().back_hits == before.back_hits + 1 ? 0 : 1);
+        });
+
+        static test_arena a{};
+        std::exit(2);
+    }, testing::ExitedWithCode(0), "");
+}
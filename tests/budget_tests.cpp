@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cma/budget.h>
+
+#include "counting_source.h"
+
+namespace {
+    using counted_arena = cma::basic_arena<cma::geometric_growth<>, cma::budgeted_block_source<cma_test::counting_source>>;
+}
+
+TEST(cma_budget, hard_limit_fails_before_allocating) {
+    cma_test::block_counts blocks {};
+    cma::memory_budget b{256 * 1024};
+    counted_arena a{64 * 1024, {&b, {&blocks}}};
+    EXPECT_EQ(blocks.allocated, 1u);
+
+    a.allocate_bytes(100 * 1024);      // second block (128 KiB + header) still fits
+    EXPECT_EQ(blocks.allocated, 2u);
+
+    EXPECT_THROW(a.allocate_bytes(200 * 1024), cma::budget_exceeded);
+    EXPECT_EQ(blocks.allocated, 2u);
+    EXPECT_EQ(a.try_allocate_bytes(200 * 1024), nullptr);
+    EXPECT_EQ(b.used(), a.footprint_bytes());
+
+    // The arena stays usable within its blocks.
+    EXPECT_NE(a.allocate_bytes(1024), nullptr);
+}
+
+TEST(cma_budget, fast_path_does_not_charge) {
+    cma::memory_budget b{1 << 20};
+    cma::budgeted_arena a{64 * 1024, {&b}};
+    const std::size_t used {b.used()};
+
+    for(int i {0}; i < 100; ++i) { a.allocate_bytes(64); }
+    EXPECT_EQ(b.used(), used);
+}
+
+TEST(cma_budget, soft_limit_calls_handler_once_per_crossing) {
+    cma::memory_budget b{std::size_t{64} << 20, 1 << 20};
+    int calls {0};
+    b.on_soft_limit([](cma::memory_budget& budget, std::size_t used, void* context) noexcept {
+        EXPECT_GE(used, budget.soft_limit());
+        ++*static_cast<int*>(context);
+    }, &calls);
+
+    cma::budgeted_arena a{64 * 1024, {&b}};
+    for(int i {0}; i < 100; ++i) { a.allocate_bytes(64 * 1024); }
+    EXPECT_EQ(calls, 1);
+
+    a.release();                                // back under the soft limit: re-armed
+    EXPECT_LT(b.used(), b.soft_limit());
+    for(int i {0}; i < 100; ++i) { a.allocate_bytes(64 * 1024); }
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(cma_budget, group_budget_spans_arenas) {
+    cma::memory_budget group{1 << 20};
+    cma::memory_budget first{1 << 20, std::numeric_limits<std::size_t>::max(), &group};
+    cma::memory_budget second{1 << 20, std::numeric_limits<std::size_t>::max(), &group};
+
+    cma::budgeted_arena a{64 * 1024, {&first}};
+    cma::budgeted_arena b{64 * 1024, {&second}};
+
+    // Either arena alone fits its own budget, but together they exhaust the group's.
+    EXPECT_NE(a.try_allocate_bytes(500 * 1024), nullptr);
+    EXPECT_EQ(b.try_allocate_bytes(500 * 1024), nullptr);
+    EXPECT_EQ(second.used(), b.footprint_bytes());
+    EXPECT_EQ(group.used(), first.used() + second.used());
+
+    a.release();
+    EXPECT_NE(b.try_allocate_bytes(500 * 1024), nullptr);
+}
+
+TEST(cma_budget, construction_is_charged) {
+    cma::memory_budget b{1024};
+    EXPECT_THROW(cma::budgeted_arena(64 * 1024, {&b}), cma::budget_exceeded);
+    EXPECT_EQ(b.used(), 0u);
+}
+
+TEST(cma_budget, no_budget_is_unlimited) {
+    cma::budgeted_arena a{};
+    EXPECT_NE(a.allocate_bytes(std::size_t{4} << 20), nullptr);
+    a.release();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <cma/concurrent_arena.h>
+
+#include <thread>
+#include <vector>
+
+TEST(cma_concurrent_arena, threads_get_disjoint_storage) {
+    cma::concurrent_arena a{1024};
+    constexpr int threads {8};
+    constexpr int per_thread {20000};
+
+    std::vector<std::vector<int*>> results(threads);
+    std::vector<std::thread> pool;
+
+    for(int t {0}; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for(int i {0}; i < per_thread; ++i) {
+                results[t].push_back(a.make<int>(t * per_thread + i));
+            }
+        });
+    }
+    for(auto& th : pool) { th.join(); }
+
+    for(int t {0}; t < threads; ++t) {
+        for(int i {0}; i < per_thread; ++i) {
+            ASSERT_EQ(*results[t][i], t * per_thread + i);
+        }
+    }
+}
+
+TEST(cma_concurrent_arena, reset_reuses_blocks) {
+    cma::concurrent_arena a{1024};
+    std::vector<void*> first;
+    for(int i {0}; i < 100; ++i) { first.push_back(a.allocate_bytes(256)); }
+
+    a.reset();
+    for(int i {0}; i < 100; ++i) { EXPECT_EQ(a.allocate_bytes(256), first[i]); }
+}
+
+TEST(cma_concurrent_arena, pmr_adaptor) {
+    cma::concurrent_arena a{};
+    cma::basic_cma_resource r{a};
+    std::pmr::vector<int> v{&r};
+    for(int i {0}; i < 10000; ++i) { v.push_back(i); }
+    EXPECT_EQ(v.back(), 9999);
+}
+
+TEST(cma_concurrent_arena, over_aligned_blocks_hold_whole_pages) {
+    using page_arena = cma::basic_concurrent_arena<cma::fixed_growth, cma::aligned_block_source<4096>>;
+    static_assert(page_arena::header_bytes == 0);
+
+    // The header is not stored in the block, so four page-aligned pages fill it exactly.
+    page_arena a{4 * 4096};
+    auto* first {static_cast<std::byte*>(a.allocate_bytes(4096, 4096))};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 4096, 0u);
+    for(std::size_t i {1}; i < 4; ++i) {
+        EXPECT_EQ(static_cast<std::byte*>(a.allocate_bytes(4096, 4096)), first + i * 4096);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cma/cmalib.h>
+
+namespace cma_test {
+
+    /**
+     * @brief Blocks counted by a @c counting_source: every one drawn, and those not yet returned.
+     */
+    struct block_counts {
+        std::size_t allocated {0};
+        std::size_t live {0};
+    };
+
+    /**
+     * @brief Heap block source counting its blocks into counters owned by the test, so tests can observe (and
+     *        compare) allocation traffic without hooking the global allocation functions.
+     */
+    struct counting_source {
+        block_counts* counts;
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return cma::heap_block_source{}.round_size(bytes); }
+
+        void* allocate(std::size_t bytes) {
+            void* p {cma::heap_block_source{}.allocate(bytes)};
+            ++counts->allocated;
+            ++counts->live;
+            return p;
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            --counts->live;
+            cma::heap_block_source{}.deallocate(p, bytes);
+        }
+    };
+
+} // namespace cma_test
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <cma/decommit.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+namespace {
+
+    /// @brief Resident set size of the process, from /proc/self/statm (0 where unavailable).
+    std::size_t resident_bytes() {
+        std::size_t pages {0};
+        if(std::FILE* f {std::fopen("/proc/self/statm", "r")}) {
+            if(std::fscanf(f, "%*s %zu", &pages) != 1) { pages = 0; }
+            std::fclose(f);
+        }
+        return pages * cma::impl::page_size();
+    }
+
+    using page_arena = cma::basic_arena<cma::geometric_growth<>, cma::decommit_block_source<cma::aligned_block_source<4096>>>;
+
+    constexpr std::size_t mib {std::size_t{1} << 20};
+
+    /// @brief Allocates and writes @p bytes in 64 KiB pieces.
+    template<typename Arena>
+    void fill(Arena& a, std::size_t bytes) {
+        for(std::size_t filled {0}; filled < bytes; filled += 64 * 1024) {
+            std::memset(a.allocate_bytes(64 * 1024), 0x5A, 64 * 1024);
+        }
+    }
+}
+
+TEST(cma_decommit, trim_returns_pages_but_keeps_blocks) {
+    if(resident_bytes() == 0) { GTEST_SKIP() << "/proc/self/statm unavailable"; }
+
+    page_arena a{mib};
+    fill(a, 64 * mib);
+
+    const std::size_t footprint {a.footprint_bytes()};
+    const std::size_t before {resident_bytes()};
+
+    a.trim(4 * mib);
+    EXPECT_EQ(a.footprint_bytes(), footprint);
+    EXPECT_LT(resident_bytes() + 48 * mib, before);
+
+    // Blocks are reused (no growth), their pages fault back in.
+    fill(a, 64 * mib);
+    EXPECT_EQ(a.footprint_bytes(), footprint);
+    EXPECT_GT(resident_bytes() + 8 * mib, before);
+}
+
+TEST(cma_decommit, retained_pages_keep_their_data) {
+    page_arena a{mib};
+    fill(a, 16 * mib);
+
+    a.trim(std::numeric_limits<std::size_t>::max());
+    auto* p {static_cast<unsigned char*>(a.allocate_bytes(64 * 1024))};
+    EXPECT_EQ(p[100], 0x5A);    // not decommitted: still the previous cycle's bytes
+}
+
+TEST(cma_decommit, hysteresis_waits_out_recent_spikes) {
+    if(resident_bytes() == 0) { GTEST_SKIP() << "/proc/self/statm unavailable"; }
+
+    page_arena a{mib};
+    cma::trim_hysteresis<4> h{mib};
+
+    fill(a, 64 * mib);
+    h.reset(a);
+    EXPECT_GE(h.retained_bytes(), 64 * mib);
+    const std::size_t spike {resident_bytes()};
+
+    // Three quiet cycles: the spike is still within the window, so nothing is given back.
+    for(int i {0}; i < 3; ++i) {
+        fill(a, 2 * mib);
+        h.reset(a);
+        EXPECT_GT(resident_bytes() + 8 * mib, spike);
+    }
+
+    // The fourth pushes it out.
+    fill(a, 2 * mib);
+    h.reset(a);
+    EXPECT_LT(h.retained_bytes(), 4 * mib);
+    EXPECT_LT(resident_bytes() + 48 * mib, spike);
+}
+
+TEST(cma_decommit, hysteresis_counts_rolled_back_extent) {
+    page_arena a{mib};
+    cma::trim_hysteresis<4> h{};
+
+    // The cycle peaks inside a scope that is rolled back before it ends.
+    fill(a, 2 * mib);
+    const auto m {a.create_marker()};
+    fill(a, 32 * mib);
+    a.rollback_to(m);
+
+    EXPECT_LT(a.extent_bytes(), 4 * mib);
+    EXPECT_GE(a.peak_extent_bytes(), 34 * mib);
+
+    h.reset(a);
+    EXPECT_GE(h.retained_bytes(), 34 * mib);
+    EXPECT_EQ(a.peak_extent_bytes(), 0u);
+}
+
+TEST(cma_decommit, hysteresis_counts_freed_top_allocations) {
+    page_arena a{mib};
+    cma::basic_cma_resource r{a};
+    cma::trim_hysteresis<4> h{};
+
+    // Freeing the vector's buffer (the top allocation) hands its bytes back to the arena before the cycle ends.
+    {
+        std::pmr::vector<unsigned char> v{&r};
+        v.resize(32 * mib, 0x5A);
+    }
+    EXPECT_LT(a.extent_bytes(), 32 * mib);
+    EXPECT_GE(a.peak_extent_bytes(), 32 * mib);
+
+    h.reset(a);
+    EXPECT_GE(h.retained_bytes(), 32 * mib);
+
+    // The retained pages were not decommitted: the next cycle finds the previous one's bytes.
+    auto* p {static_cast<unsigned char*>(a.allocate_bytes(32 * mib))};
+    EXPECT_EQ(p[16 * mib], 0x5A);
+}
+
+TEST(cma_decommit, extent_counts_skipped_tails) {
+    cma::trimming_arena a{4096};
+    a.allocate_bytes(3000);
+    a.allocate_bytes(3000);     // does not fit: the rest of the first block is skipped
+
+    EXPECT_EQ(a.bytes_in_use(), 6000u);
+    EXPECT_GT(a.extent_bytes(), a.bytes_in_use());
+}
+
+TEST(cma_decommit, lazy_advice) {
+    cma::basic_arena<cma::geometric_growth<>, cma::decommit_block_source<cma::heap_block_source, cma::page_advice::free>> a{mib};
+    fill(a, 8 * mib);
+    a.trim(0);
+    fill(a, 8 * mib);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cma/deferred_release.h>
+
+#include <atomic>
+
+namespace {
+
+    /// @brief Stateless heap source counting the bytes it has outstanding.
+    struct tracking_source {
+        static inline std::atomic<std::size_t> outstanding {0};
+
+        std::size_t round_size(std::size_t bytes) const noexcept { return bytes; }
+
+        void* allocate(std::size_t bytes) {
+            outstanding += bytes;
+            return ::operator new(bytes);
+        }
+
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            outstanding -= bytes;
+            ::operator delete(p);
+        }
+    };
+
+    using deferred_tracking_arena = cma::basic_arena<cma::geometric_growth<>, cma::deferred_block_source<tracking_source>, cma::counting_stats>;
+}
+
+TEST(cma_deferred_release, destruction_hands_over_the_chain) {
+    cma::block_reclaimer r{};
+    std::size_t footprint {0};
+
+    {
+        deferred_tracking_arena a{4096, {&r}};
+        for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+
+        footprint = a.footprint_bytes();
+        EXPECT_EQ(footprint, a.snapshot().footprint_bytes);
+        EXPECT_EQ(tracking_source::outstanding.load(), footprint);
+    }
+
+    EXPECT_EQ(r.stats().deferred, 1u);
+    EXPECT_EQ(r.stats().synchronous, 0u);
+
+    r.drain();
+    EXPECT_EQ(r.stats().pending_bytes, 0u);
+    EXPECT_EQ(tracking_source::outstanding.load(), 0u);
+}
+
+TEST(cma_deferred_release, release_hands_over_dropped_blocks) {
+    cma::block_reclaimer r{};
+    deferred_tracking_arena a{4096, {&r}};
+
+    for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+    const std::size_t before {a.footprint_bytes()};
+
+    a.release();
+    EXPECT_EQ(r.stats().deferred, 1u);
+    EXPECT_LT(a.footprint_bytes(), before);
+    EXPECT_EQ(a.footprint_bytes(), a.snapshot().footprint_bytes);
+
+    r.drain();
+    EXPECT_EQ(tracking_source::outstanding.load(), a.footprint_bytes());
+
+    // Nothing to drop: no chain is handed over.
+    a.release();
+    EXPECT_EQ(r.stats().deferred, 1u);
+}
+
+TEST(cma_deferred_release, pending_bytes_are_bounded) {
+    cma::block_reclaimer r{64 * 1024};
+
+    {
+        deferred_tracking_arena a{4096, {&r}};
+        for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+        ASSERT_GT(a.footprint_bytes(), 64u * 1024);
+    }
+
+    // Over the limit, the chain was freed on the spot.
+    EXPECT_EQ(r.stats().deferred, 0u);
+    EXPECT_EQ(r.stats().synchronous, 1u);
+    EXPECT_EQ(tracking_source::outstanding.load(), 0u);
+}
+
+TEST(cma_deferred_release, many_arenas_drain_through_one_reclaimer) {
+    cma::block_reclaimer r{};
+
+    for(int n {0}; n < 200; ++n) {
+        deferred_tracking_arena a{4096, {&r}};
+        for(int i {0}; i < 100; ++i) { a.allocate_bytes(1000); }
+    }
+
+    r.drain();
+    EXPECT_EQ(r.stats().deferred + r.stats().synchronous, 200u);
+    EXPECT_EQ(tracking_source::outstanding.load(), 0u);
+}
+
+TEST(cma_deferred_release, default_arena_tracks_its_footprint) {
+    cma::basic_arena<cma::geometric_growth<>, cma::heap_block_source, cma::counting_stats> a{4096};
+    for(int i {0}; i < 1000; ++i) { a.allocate_bytes(1000); }
+    EXPECT_EQ(a.footprint_bytes(), a.snapshot().footprint_bytes);
+
+    a.release();
+    EXPECT_EQ(a.footprint_bytes(), a.snapshot().footprint_bytes);
+}
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include <cma/huge_pages.h>
+
+#include <cstring>
+
+TEST(cma_huge_pages, source_rounds_and_aligns) {
+    cma::huge_page_block_source<> s{};
+    constexpr std::size_t page {cma::huge_page_block_source<>::page_bytes};
+    EXPECT_EQ(s.round_size(1), page);
+    EXPECT_EQ(s.round_size(page + 1), 2 * page);
+
+    void* p {s.allocate(2 * page)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % page, 0u);
+    std::memset(p, 0x5A, 2 * page);
+    s.deallocate(p, 2 * page);
+}
+
+TEST(cma_huge_pages, arena_allocates) {
+    cma::huge_page_arena a{};
+    cma::basic_cma_resource r{a};
+    std::pmr::vector<std::uint64_t> v{&r};
+    for(std::uint64_t i {0}; i < (1u << 20); ++i) { v.push_back(i); }
+    EXPECT_EQ(v[12345], 12345u);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <cma/mmap_arena.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+    struct list_node {
+        std::uint64_t next;     // offset of the next node (0 = end), valid wherever the file is mapped
+        int value;
+    };
+
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+}
+
+TEST(cma_mmap_arena, build_then_map_read_only) {
+    const std::string path {temp_path("cma_mmap_arena_build.bin")};
+    void* built_at {nullptr};
+
+    {
+        cma::mmap_arena a{path.c_str(), cma::mmap_mode::create, std::size_t{1} << 30};
+        built_at = a.base();
+
+        std::uint64_t head {0};
+        for(int i {0}; i < 1000; ++i) {
+            auto* n {a.make<list_node>(list_node{head, i})};
+            head = a.offset_of(n);
+        }
+
+        a.set_root(a.at<list_node>(head));
+        a.sync();
+    }
+
+    cma::mmap_arena r{path.c_str(), cma::mmap_mode::read_only};
+    EXPECT_TRUE(r.read_only());
+    EXPECT_EQ(r.used_bytes(), 1000 * sizeof(list_node));
+    if(!r.relocated()) { EXPECT_EQ(r.base(), built_at); }
+
+    int expected {999};
+    for(auto* n {r.root<list_node>()}; n; n = n->next ? r.at<list_node>(n->next) : nullptr) {
+        EXPECT_EQ(n->value, expected--);
+    }
+    EXPECT_EQ(expected, -1);
+    EXPECT_THROW(r.allocate_bytes(16), std::bad_alloc);
+
+    std::filesystem::remove(path);
+}
+
+TEST(cma_mmap_arena, grows_in_recorded_blocks) {
+    const std::string path {temp_path("cma_mmap_arena_grow.bin")};
+
+    {
+        cma::mmap_arena a{path.c_str(), cma::mmap_mode::create, std::size_t{1} << 30};
+        auto* big {static_cast<std::byte*>(a.allocate_bytes(3 << 20))};
+        big[(3 << 20) - 1] = std::byte{7};
+
+        auto* more {static_cast<std::byte*>(a.allocate_bytes(8 << 20))};
+        more[0] = std::byte{9};
+
+        ASSERT_GE(a.blocks().size(), 2u);
+        for(const auto& b : a.blocks()) { EXPECT_EQ(b.offset + b.size <= a.mapped_bytes(), true); }
+        EXPECT_EQ(a.blocks().back().offset + a.blocks().back().size, a.mapped_bytes());
+        EXPECT_EQ(std::filesystem::file_size(path), a.mapped_bytes());
+    }
+
+    {
+        cma::mmap_arena a{path.c_str(), cma::mmap_mode::open};
+        const std::size_t used {a.used_bytes()};
+        EXPECT_GE(used, std::size_t{11} << 20);
+        a.make<int>(1);
+        EXPECT_GT(a.used_bytes(), used);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(cma_mmap_arena, rejects_foreign_files) {
+    const std::string path {temp_path("cma_mmap_arena_foreign.bin")};
+    std::ofstream{path} << std::string(8192, 'x');
+
+    EXPECT_THROW((cma::mmap_arena{path.c_str(), cma::mmap_mode::read_only}), std::runtime_error);
+    EXPECT_THROW((cma::mmap_arena{"/nonexistent/cma.bin", cma::mmap_mode::read_only}), std::system_error);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cma/numa.h>
+
+#include <cstring>
+
+TEST(cma_numa, node_queries) {
+    EXPECT_GE(cma::numa_node_count(), 1);
+
+    const int node {cma::numa_current_node()};
+    EXPECT_GE(node, 0);
+    EXPECT_LT(node, cma::numa_node_count());
+}
+
+TEST(cma_numa, source_places_blocks) {
+    for(const int node : {cma::numa_block_source::local_node, 0}) {
+        cma::numa_block_source s{node};
+        const std::size_t bytes {s.round_size(1 << 20)};
+
+        void* p {s.allocate(bytes)};
+        std::memset(p, 0x5A, bytes);
+
+        // -1 only where the kernel refuses the query.
+        const int placed {cma::numa_node_of(p)};
+        if(placed != -1) {
+            EXPECT_LT(placed, cma::numa_node_count());
+            if(node == 0) { EXPECT_EQ(placed, 0); }
+        }
+        s.deallocate(p, bytes);
+    }
+}
+
+TEST(cma_numa, strict_source_refuses_unplaceable_blocks) {
+    const int missing {cma::numa_node_count()};
+    const std::size_t bytes {cma::numa_block_source{}.round_size(1 << 20)};
+
+    cma::numa_block_source strict{missing, true};
+    EXPECT_THROW(strict.allocate(bytes), std::bad_alloc);
+
+    // Preferred placement falls back to first touch instead.
+    cma::numa_block_source preferred{missing, false};
+    void* p {preferred.allocate(bytes)};
+    EXPECT_NE(p, nullptr);
+    preferred.deallocate(p, bytes);
+
+    // The only node of a single-node system always places (elsewhere, binding may be denied in containers).
+    if(cma::numa_node_count() == 1) {
+        cma::numa_block_source local{cma::numa_block_source::local_node, true};
+        void* q {local.allocate(bytes)};
+        std::memset(q, 0x5A, bytes);
+        local.deallocate(q, bytes);
+    }
+}
+
+TEST(cma_numa, arena_allocates_on_current_node) {
+    cma::numa_arena a{};
+    auto* p {static_cast<std::byte*>(a.allocate_bytes(1 << 16, 4096))};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 4096, 0u);
+    std::memset(p, 1, 1 << 16);
+    EXPECT_LT(cma::numa_node_of(p), cma::numa_node_count());
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <cma/offset_ptr.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+static_assert(std::contiguous_iterator<cma::offset_ptr<int>>);
+static_assert(std::is_same_v<std::pointer_traits<cma::offset_ptr<int>>::rebind<long>, cma::offset_ptr<long>>);
+
+TEST(cma_offset_ptr, pointer_semantics) {
+    int values[4] {1, 2, 3, 4};
+
+    cma::offset_ptr<int> p {values};
+    cma::offset_ptr<int> q {p};
+    EXPECT_EQ(q.get(), values);
+    EXPECT_EQ(*++q, 2);
+    EXPECT_EQ(q[2], 4);
+    EXPECT_EQ((p + 3) - p, 3);
+    EXPECT_LT(p, q);
+
+    cma::offset_ptr<const int> c {q};
+    EXPECT_EQ(*c, 2);
+
+    cma::offset_ptr<void> v {p};
+    EXPECT_EQ(static_cast<cma::offset_ptr<int>>(v), p);
+
+    cma::offset_ptr<int> n {};
+    EXPECT_FALSE(n);
+    EXPECT_EQ(n, nullptr);
+    EXPECT_EQ(n.get(), nullptr);
+}
+
+namespace {
+    struct node {
+        cma::offset_ptr<node> next;
+        int value;
+    };
+}
+
+TEST(cma_offset_ptr, survives_relocation) {
+    cma::arena a{};
+    auto* storage {static_cast<std::byte*>(a.allocate_bytes(sizeof(node) * 16, alignof(node)))};
+    auto* nodes {reinterpret_cast<node*>(storage)};
+
+    for(int i {0}; i < 16; ++i) {
+        ::new (&nodes[i]) node{i + 1 < 16 ? &nodes[i + 1] : nullptr, i};
+    }
+
+    // Copy the whole region elsewhere; the list stays intact because every link is relative.
+    auto* moved {static_cast<std::byte*>(a.allocate_bytes(sizeof(node) * 16, alignof(node)))};
+    std::memcpy(moved, storage, sizeof(node) * 16);
+    std::memset(storage, 0, sizeof(node) * 16);
+
+    int expected {0};
+    for(auto* n {reinterpret_cast<node*>(moved)}; n; n = n->next.get()) {
+        EXPECT_EQ(n->value, expected++);
+    }
+    EXPECT_EQ(expected, 16);
+}
+
+TEST(cma_offset_allocator, standard_containers) {
+    cma::arena a{};
+
+    std::vector<int, cma::offset_allocator<int>> v{cma::offset_allocator<int>{a}};
+    for(int i {0}; i < 1000; ++i) { v.push_back(999 - i); }
+    std::ranges::sort(v);
+    EXPECT_EQ(v.front(), 0);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 999 * 1000 / 2);
+
+    std::deque<int, cma::offset_allocator<int>> d{cma::offset_allocator<int>{a}};
+    for(int i {0}; i < 5000; ++i) { d.push_front(i); }
+    EXPECT_EQ(d.back(), 0);
+    EXPECT_EQ(d[0], 4999);
+}
@@ -22,3 +22,26 @@ TEST(cma_pmr_adaptor, vector_adaptor) {
     v.pop_back();
     EXPECT_EQ(v.empty(), true);
 }
+
+namespace {
+    // The adaptor names stay plain types over the default arena.
+    struct holder {
+        cma::arena a{};
+        cma::cma_resource r{a};
+        std::vector<int, cma::cma_allocator<int>> v{cma::cma_allocator<int>{a}};
+    };
+
+    std::size_t use(cma::cma_resource& r) {
+        std::pmr::vector<int> v{&r};
+        v.assign(10, 1);
+        return v.size();
+    }
+}
+
+TEST(cma_pmr_adaptor, default_arena_names) {
+    holder h{};
+    EXPECT_EQ(use(h.r), 10u);
+    h.v.push_back(3);
+    EXPECT_EQ(h.v.back(), 3);
+    static_assert(std::is_same_v<cma::cma_allocator<int>, cma::basic_cma_allocator<int, cma::arena>>);
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <cma/prefault.h>
+
+#include <cstring>
+
+#include <sys/resource.h>
+
+namespace {
+    long minor_faults() {
+        rusage u {};
+        ::getrusage(RUSAGE_SELF, &u);
+        return u.ru_minflt;
+    }
+}
+
+TEST(cma_prefault, blocks_are_faulted_in_at_creation) {
+    constexpr std::size_t block {std::size_t{8} << 20};
+    cma::basic_arena<cma::fixed_growth, cma::prefault_block_source<cma::aligned_block_source<4096>>> a{block};
+    a.reserve_blocks(3);
+
+    // Filling all four blocks (8192 pages) touches no page that was not already faulted in.
+    const long before {minor_faults()};
+    for(int i {0}; i < 4; ++i) {
+        std::memset(a.allocate_bytes(block, 4096), 0x5A, block);
+    }
+    EXPECT_LT(minor_faults() - before, 64);
+}
+
+TEST(cma_prefault, unaligned_storage) {
+    cma::prefault_block_source<> s{};
+    void* p {s.allocate(100'000)};
+    std::memset(p, 1, 100'000);
+    s.deallocate(p, 100'000);
+}
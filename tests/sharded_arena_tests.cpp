@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <cma/sharded_arena.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST(cma_sharded_arena, one_shard_per_cpu) {
+    cma::sharded_arena a{};
+    EXPECT_GE(a.shard_count(), 1u);
+    EXPECT_LT(cma::impl::current_cpu() % a.shard_count(), a.shard_count());
+}
+
+TEST(cma_sharded_arena, threads_get_disjoint_storage) {
+    cma::sharded_arena a{4096};
+    constexpr int threads {8};
+    constexpr int per_thread {20000};
+
+    std::vector<std::vector<int*>> results(threads);
+    std::vector<std::thread> pool;
+
+    for(int t {0}; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            for(int i {0}; i < per_thread; ++i) {
+                results[t].push_back(a.make<int>(t * per_thread + i));
+            }
+        });
+    }
+    for(auto& th : pool) { th.join(); }
+
+    for(int t {0}; t < threads; ++t) {
+        for(int i {0}; i < per_thread; ++i) {
+            ASSERT_EQ(*results[t][i], t * per_thread + i);
+        }
+    }
+}
+
+TEST(cma_sharded_arena, large_requests_and_reset) {
+    cma::sharded_arena a{4096};
+    auto* big {static_cast<std::byte*>(a.allocate_bytes(64 * 1024))};
+    std::memset(big, 0x11, 64 * 1024);
+
+    void* small {a.allocate_bytes(64)};
+    a.reset();
+    EXPECT_NE(a.allocate_bytes(64), nullptr);
+    EXPECT_NE(small, nullptr);
+
+    cma::basic_cma_resource r{a};
+    std::pmr::vector<int> v{&r};
+    for(int i {0}; i < 10000; ++i) { v.push_back(i); }
+    EXPECT_EQ(v.back(), 9999);
+}
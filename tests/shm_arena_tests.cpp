@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cma/shm_arena.h>
+
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+    struct message {
+        cma::offset_ptr<int> payload;
+        std::size_t count;
+    };
+
+    /// @brief Runs @p child in a forked process and returns its exit status.
+    template<typename F>
+    int in_child(F&& child) {
+        const pid_t pid {::fork()};
+        if(pid == 0) { ::_exit(child()); }
+
+        int status {0};
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+}
+
+TEST(cma_shm_arena, child_builds_parent_reads) {
+    cma::shm_arena a{1 << 20};
+
+    const int status {in_child([&] {
+        auto* m {a.make<message>()};
+        int* payload {static_cast<int*>(a.allocate_bytes(1000 * sizeof(int), alignof(int)))};
+        for(int i {0}; i < 1000; ++i) { payload[i] = i * i; }
+
+        m->payload = payload;
+        m->count = 1000;
+        a.publish(m);
+        return 0;
+    })};
+    ASSERT_EQ(status, 0);
+
+    const auto* m {a.root<message>()};
+    ASSERT_NE(m, nullptr);
+    ASSERT_EQ(m->count, 1000u);
+    EXPECT_EQ(m->payload[999], 999 * 999);
+    EXPECT_GE(a.used_bytes(), sizeof(message) + 1000 * sizeof(int));
+}
+
+TEST(cma_shm_arena, processes_share_the_cursor) {
+    constexpr int per_process {20000};
+    cma::shm_arena a{std::size_t{8} << 20};
+    const auto* start {static_cast<std::uint64_t*>(a.allocate_bytes(32, 8))};
+
+    // Each process tags its 32-byte allocations; any overlap would leave a foreign or torn tag behind.
+    auto fill {[&](std::uint64_t tag) {
+        for(int i {0}; i < per_process; ++i) {
+            auto* p {static_cast<std::uint64_t*>(a.allocate_bytes(32, 8))};
+            for(int j {0}; j < 4; ++j) { p[j] = tag; }
+        }
+    }};
+
+    const pid_t pid {::fork()};
+    if(pid == 0) {
+        fill(2);
+        ::_exit(0);
+    }
+    fill(1);
+
+    int status {0};
+    ::waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    EXPECT_EQ(a.used_bytes(), 32 + 2u * per_process * 32);
+
+    std::size_t tagged[3] {};
+    for(int i {0}; i < 2 * per_process; ++i) {
+        const std::uint64_t* p {start + 4 * (i + 1)};
+        ASSERT_TRUE(p[0] == 1 || p[0] == 2);
+        for(int j {1}; j < 4; ++j) { ASSERT_EQ(p[j], p[0]); }
+        ++tagged[p[0]];
+    }
+    EXPECT_EQ(tagged[1], std::size_t{per_process});
+    EXPECT_EQ(tagged[2], std::size_t{per_process});
+}
+
+TEST(cma_shm_arena, named_segment) {
+    const std::string name {"/cma_shm_arena_test." + std::to_string(::getpid())};
+
+    cma::shm_arena producer{name.c_str(), cma::shm_mode::create, 1 << 16};
+    producer.publish(producer.make<int>(42));
+
+    cma::shm_arena consumer{name.c_str(), cma::shm_mode::open};
+    cma::shm_arena::unlink(name.c_str());
+
+    EXPECT_NE(consumer.base(), producer.base());
+    ASSERT_NE(consumer.root<int>(), nullptr);
+    EXPECT_EQ(*consumer.root<int>(), 42);
+    EXPECT_THROW(consumer.allocate_bytes(1 << 17), std::bad_alloc);
+}
+
+TEST(cma_shm_arena, alignment_is_bounded_by_the_page_size) {
+    cma::shm_arena a{1 << 20};
+    const std::size_t page {cma::impl::page_size()};
+
+    // Page alignment holds in every process's mapping, so it is the same offset everywhere.
+    a.allocate_bytes(1);
+    void* p {a.allocate_bytes(64, page)};
+    EXPECT_EQ(a.offset_of(p) % page, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % page, 0u);
+
+    EXPECT_THROW(a.allocate_bytes(64, page * 2), std::bad_alloc);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <cma/virtual_arena.h>
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+TEST(cma_virtual_arena, marker_is_single_pointer) {
+    EXPECT_EQ(sizeof(cma::virtual_arena::marker), sizeof(void*));
+}
+
+TEST(cma_virtual_arena, contiguous_across_commits) {
+    cma::virtual_arena a{std::size_t{1} << 30, 4096};
+    std::byte* base {a.base()};
+
+    auto* first {static_cast<std::byte*>(a.allocate_bytes(3000, 1))};
+    auto* second {static_cast<std::byte*>(a.allocate_bytes(3000, 1))}; // crosses a commit boundary
+    EXPECT_EQ(first, base);
+    EXPECT_EQ(second, first + 3000);
+    std::memset(first, 0xAB, 6000);
+
+    auto* big {static_cast<std::byte*>(a.allocate_bytes(1 << 20))};
+    std::memset(big, 0xCD, 1 << 20);
+    EXPECT_EQ(a.base(), base);
+    EXPECT_GE(a.committed_bytes(), a.used_bytes());
+}
+
+TEST(cma_virtual_arena, rollback_and_reset) {
+    cma::virtual_arena a{std::size_t{1} << 30};
+    a.allocate_bytes(100);
+    const auto m {a.create_marker()};
+    void* p {a.allocate_bytes(5000)};
+    a.rollback_to(m);
+    EXPECT_EQ(a.allocate_bytes(5000), p);
+
+    a.reset();
+    EXPECT_EQ(a.used_bytes(), 0u);
+
+    a.release();
+    EXPECT_EQ(a.committed_bytes(), 0u);
+    int* i {a.make<int>(7)};
+    EXPECT_EQ(*i, 7);
+}
+
+TEST(cma_virtual_arena, release_keeps_everything_on_request) {
+    cma::virtual_arena a{std::size_t{1} << 30};
+    std::memset(a.allocate_bytes(1 << 20), 0x5A, 1 << 20);
+    const std::size_t committed {a.committed_bytes()};
+
+    a.release(std::numeric_limits<std::size_t>::max());
+    EXPECT_EQ(a.committed_bytes(), committed);
+    EXPECT_EQ(static_cast<unsigned char*>(a.allocate_bytes(1 << 20))[4096], 0x5A);
+}
+
+TEST(cma_virtual_arena, exhausted_reservation_throws) {
+    cma::virtual_arena a{64 * 1024, 4096};
+    EXPECT_THROW(a.allocate_bytes(128 * 1024), std::bad_alloc);
+    EXPECT_NE(a.allocate_bytes(1024), nullptr);
+}
+
+TEST(cma_virtual_arena, pmr_and_allocator_adaptors) {
+    cma::virtual_arena a{std::size_t{1} << 30};
+    cma::basic_cma_resource r{a};
+    std::pmr::vector<int> v{&r};
+    for(int i {0}; i < 100000; ++i) { v.push_back(i); }
+    EXPECT_EQ(v.back(), 99999);
+
+    std::vector<int, cma::basic_cma_allocator<int, cma::virtual_arena>> w{cma::basic_cma_allocator<int, cma::virtual_arena>{a}};
+    w.assign(1000, 3);
+    EXPECT_EQ(w[999], 3);
+}